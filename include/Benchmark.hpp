@@ -0,0 +1,41 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct BenchmarkResult
+{
+	std::string name_;
+	int samples_;
+	std::uint64_t operations_;
+	double min_ns_;
+	double p50_ns_;
+	double mean_ns_;
+};
+
+class Benchmark
+{
+private:
+	int samples_;
+	std::vector<BenchmarkResult> results_;
+
+public:
+	using Setup = std::function<void()>;
+	using Batch = std::function<std::uint64_t()>;
+
+	Benchmark(int samples);
+
+	const BenchmarkResult& Run(const std::string& name, const Setup& setup, const Batch& batch);
+
+	const std::vector<BenchmarkResult>& GetResults() const;
+
+	void Print() const;
+
+	bool Dump(const std::string& path) const;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include <array>
+#include <cstdint>
+
+class Bitboard
+{
+public:
+	using Row = std::uint16_t;
+	using PieceRows = std::array<Row, 4>;
+
+	static constexpr int max_width = 16;
+	static constexpr int max_height = 64;
+
+private:
+	int width_;
+	int height_;
+	Row full_row_;
+	std::array<Row, max_height> rows_;
+	std::uint64_t hash_;
+	mutable std::array<int, max_width> column_tops_;
+	mutable bool column_tops_dirty_;
+
+	void UpdateColumnTops() const;
+
+	static std::uint64_t GetRowHash(int y, Row bits);
+
+public:
+	Bitboard();
+
+	void Resize(int width, int height);
+
+	void Clear();
+
+	int GetWidth() const;
+
+	int GetHeight() const;
+
+	Row GetRow(int y) const;
+
+	const Row* GetRows() const;
+
+	void SetRow(int y, Row row);
+
+	Row GetFullRow() const;
+
+	bool IsRowFull(int y) const;
+
+	bool IsRowEmpty(int y) const;
+
+	bool IsOccupied(int x, int y) const;
+
+	void SetOccupied(int x, int y, bool occupied);
+
+	int GetColumnTop(int x) const;
+
+	bool Collides(const PieceRows& rows, int x, int y) const;
+
+	int ClearFullRows();
+
+	std::uint64_t GetHash() const;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef BOARD_FEATURES_HPP
+#define BOARD_FEATURES_HPP
+
+#include "Bitboard.hpp"
+
+#include <cstddef>
+#include <vector>
+
+struct BoardFeatures
+{
+	int aggregate_height_;
+	int holes_;
+	int bumpiness_;
+	int max_height_;
+	int row_transitions_;
+	int wells_;
+};
+
+enum class FeatureKernel
+{
+	SCALAR,
+	SSSE3,
+	AVX2,
+	COUNT
+};
+
+// Candidate boards stored row-interleaved: row y of board i lives at y * stride + i, so one vector
+// load reads the same row of consecutive boards. Unused lanes stay empty.
+class BoardBatch
+{
+public:
+	static constexpr std::size_t lanes = 16;
+
+private:
+	int width_;
+	int height_;
+	std::size_t size_;
+	std::size_t stride_;
+	std::vector<Bitboard::Row> rows_;
+
+public:
+	BoardBatch();
+
+	void Reset(int width, int height, std::size_t capacity);
+
+	std::size_t Add(const Bitboard& bitboard);
+
+	int GetWidth() const;
+
+	int GetHeight() const;
+
+	std::size_t GetSize() const;
+
+	std::size_t GetStride() const;
+
+	const Bitboard::Row* GetRows() const;
+};
+
+BoardFeatures ExtractBoardFeatures(const Bitboard& bitboard);
+
+void ExtractBoardFeatures(const BoardBatch& batch, BoardFeatures* features, FeatureKernel kernel);
+
+void ExtractBoardFeatures(const BoardBatch& batch, BoardFeatures* features);
+
+bool IsFeatureKernelSupported(FeatureKernel kernel);
+
+FeatureKernel GetFeatureKernel();
+
+const char* GetFeatureKernelName(FeatureKernel kernel);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef BOARD_LAYER_HPP
+#define BOARD_LAYER_HPP
+
+#include <SDL2/SDL.h>
+
+class BoardLayer
+{
+private:
+	SDL_Texture* texture_;
+	int width_;
+	int height_;
+	bool dirty_;
+
+public:
+	BoardLayer();
+
+	~BoardLayer();
+
+	void FreeTexture();
+
+	bool Create(SDL_Renderer* renderer, int width, int height);
+
+	void MarkDirty();
+
+	bool IsDirty() const;
+
+	void BeginRedraw(SDL_Renderer* renderer);
+
+	void EndRedraw(SDL_Renderer* renderer);
+
+	void Render(SDL_Renderer* renderer, int x, int y);
+};
+
+#endif
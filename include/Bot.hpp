@@ -0,0 +1,142 @@
+#ifndef BOT_HPP
+#define BOT_HPP
+
+#include "Bitboard.hpp"
+#include "BoardFeatures.hpp"
+#include "Engine.hpp"
+#include "Input.hpp"
+#include "PieceState.hpp"
+#include "RotationTables.hpp"
+#include "TetrominoType.hpp"
+#include "TranspositionTable.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct BotWeights
+{
+	double aggregate_height_;
+	double holes_;
+	double bumpiness_;
+	double lines_cleared_;
+	double row_transitions_;
+	double wells_;
+};
+
+struct BotOptions
+{
+	BotWeights weights_;
+	int lookahead_;
+	bool use_stash_;
+	int transposition_bits_;
+};
+
+enum class BotAction : std::uint8_t
+{
+	LEFT,
+	RIGHT,
+	DOWN,
+	ROTATE_CLOCKWISE,
+	ROTATE_COUNTERCLOCKWISE,
+	STASH,
+	HARD_DROP
+};
+
+struct BotPlan
+{
+	PieceState target_;
+	bool stash_;
+	double score_;
+	std::vector<BotAction> actions_;
+};
+
+class Bot
+{
+private:
+	struct SearchNode
+	{
+		PieceState state_;
+		int parent_;
+		BotAction action_;
+	};
+
+	struct Candidate
+	{
+		std::uint64_t key_;
+		int cleared_;
+		int batch_index_;
+		double score_;
+	};
+
+	BotOptions options_;
+	std::vector<std::uint32_t> visited_;
+	std::uint32_t visit_stamp_;
+	std::vector<SearchNode> nodes_;
+	std::vector<std::vector<PieceState>> placements_;
+	std::vector<Bitboard> boards_;
+	std::vector<std::vector<Candidate>> candidates_;
+	BoardBatch batch_;
+	std::vector<BoardFeatures> batch_features_;
+	std::array<PieceState, rotation_tables::types> spawn_states_;
+	std::shared_ptr<TranspositionTable> transposition_table_;
+	std::uint64_t evaluated_placements_;
+	std::uint64_t cache_probes_;
+	std::uint64_t cache_hits_;
+	double think_seconds_;
+
+	std::size_t GetStateIndex(const Bitboard& bitboard, const PieceState& state) const;
+
+	void Explore(const Bitboard& bitboard, const PieceState& start, std::vector<PieceState>* placements);
+
+	double EvaluateBoard(const BoardFeatures& features) const;
+
+	double Search(std::size_t depth, const PieceState& start, const TetrominoType* next, std::size_t remaining, std::uint64_t stash_key, PieceState* best);
+
+public:
+	Bot(const BotOptions& options, std::shared_ptr<TranspositionTable> transposition_table = nullptr);
+
+	static BotWeights GetDefaultWeights();
+
+	static BotOptions GetDefaultOptions();
+
+	const BotOptions& GetOptions() const;
+
+	void SetWeights(const BotWeights& weights);
+
+	bool Think(const Engine& engine, BotPlan* plan);
+
+	bool FindPath(const Bitboard& bitboard, const PieceState& start, const PieceState& target, std::vector<BotAction>* actions);
+
+	std::uint64_t GetEvaluatedPlacements() const;
+
+	double GetThinkSeconds() const;
+
+	std::uint64_t GetCacheProbes() const;
+
+	std::uint64_t GetCacheHits() const;
+};
+
+class BotPlayer
+{
+private:
+	Bot bot_;
+	BotPlan plan_;
+	std::size_t next_action_;
+	bool has_plan_;
+	PieceState expected_;
+	std::uint64_t board_version_;
+	bool holding_;
+	Input release_input_;
+
+public:
+	BotPlayer(const BotOptions& options, std::shared_ptr<TranspositionTable> transposition_table = nullptr);
+
+	void Update(const Engine& engine, std::vector<Input>* inputs);
+
+	const Bot& GetBot() const;
+};
+
+#endif
@@ -6,6 +6,9 @@ namespace constants
 	inline constexpr char game_title[] = "Tetris"; 
 	inline constexpr int screen_width = 960;
 	inline constexpr int screen_height = 640;
+	inline constexpr int cell_size = 32;
+	inline constexpr int board_cells_width = screen_width / 3 / cell_size;
+	inline constexpr int board_cells_height = screen_height / cell_size;
 } // namespace constants
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,37 @@
+#ifndef DRAW_LIST_HPP
+#define DRAW_LIST_HPP
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+#include <vector>
+
+class DrawList
+{
+public:
+	enum class Mode
+	{
+		FILL, OUTLINE
+	};
+
+private:
+	struct Group
+	{
+		SDL_Color color_;
+		Mode mode_;
+		std::vector<SDL_Rect> rects_;
+	};
+
+	std::vector<Group> groups_;
+
+public:
+	std::size_t AddGroup(const SDL_Color& color, Mode mode);
+
+	void AddRect(std::size_t group, const SDL_Rect& rect);
+
+	void Submit(SDL_Renderer* renderer);
+
+	void Clear();
+};
+
+#endif
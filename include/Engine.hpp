@@ -0,0 +1,157 @@
+#ifndef ENGINE_HPP
+#define ENGINE_HPP
+
+#include "Bitboard.hpp"
+#include "Input.hpp"
+#include "PieceSource.hpp"
+#include "PieceState.hpp"
+#include "TetrominoType.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+struct ClearedLines
+{
+	int count_;
+	std::array<int, 4> rows_;
+};
+
+// Auto-shift timing in milliseconds. DAS is the delay from a press to the first repeat, ARR the delay
+// between repeats (0 shifts straight to the wall) and soft drop falls this many times faster than gravity.
+struct HandlingOptions
+{
+	int das_ms_;
+	int arr_ms_;
+	int soft_drop_factor_;
+};
+
+class Engine
+{
+private:
+	int ticks_;
+	int shift_direction_;
+	int shift_ticks_;
+	int drop_ticks_;
+	int score_;
+	int lines_;
+	int descend_ms_;
+	int tick_rate_;
+	int descend_ticks_;
+	int das_ticks_;
+	int arr_ticks_;
+	bool game_over_;
+	bool moving_left_;
+	bool moving_right_;
+	bool moving_down_;
+	bool unstash_possible_;
+	std::uint64_t board_version_;
+	ClearedLines last_cleared_lines_;
+	HandlingOptions handling_;
+
+	PieceSource piece_source_;
+
+	std::optional<TetrominoType> stashed_type_;
+	PieceState falling_piece_;
+	int falling_drop_distance_;
+
+	void SetFallingPiece(const PieceState& piece);
+
+	bool DescendFallingPiece(int* score);
+
+	bool ShiftFallingPiece(int dx);
+
+	void RepeatShift();
+
+	void SoftDropFallingPiece();
+
+	int GetSoftDropInterval() const;
+
+	int ToTicks(int ms) const;
+
+	void UpdateTiming();
+
+public:
+	int cells_width_;
+	int cells_height_;
+
+	std::array<TetrominoType, Bitboard::max_width * Bitboard::max_height> cell_types_;
+	Bitboard bitboard_;
+
+	Engine(int cells_width, int cells_height, std::uint32_t seed, PieceSourceMode piece_source_mode = PieceSourceMode::SEVEN_BAG);
+
+	static constexpr int default_tick_rate = 60;
+
+	// Narrowest and shortest boards every piece can spawn inside.
+	static constexpr int min_cells_width = 6;
+	static constexpr int min_cells_height = 4;
+
+	static HandlingOptions GetDefaultHandling();
+
+	void Reset();
+
+	void Tick();
+
+	void ApplyInput(Input input);
+
+	void RotateTetromino(int degrees);
+
+	void SetMovingLeft(bool moving);
+
+	void SetMovingRight(bool moving);
+
+	void SetMovingDown(bool moving);
+
+	void HardDropTetromino();
+
+	void TriggerStashTetromino();
+
+	bool PlacePiece(const PieceState& piece);
+
+	void SetHandling(const HandlingOptions& handling);
+
+	const HandlingOptions& GetHandling() const;
+
+	void SetTickRate(int ticks_per_second);
+
+	int GetTickRate() const;
+
+	int GetTicks() const;
+
+	int GetScore() const;
+
+	int GetLines() const;
+
+	bool IsGameOver() const;
+
+	std::uint32_t GetSeed() const;
+
+	std::uint64_t GetBoardVersion() const;
+
+	std::uint64_t GetBoardHash() const;
+
+	const ClearedLines& GetLastClearedLines() const;
+
+	const PieceState& GetFallingPiece() const;
+
+	int GetFallingDropDistance() const;
+
+	const std::optional<TetrominoType>& GetStashedType() const;
+
+	bool CanStash() const;
+
+	TetrominoType GetQueuedType(std::size_t index) const;
+
+	const PieceSource& GetPieceSource() const;
+
+	PieceState GetSpawnState(TetrominoType type) const;
+
+	void SpawnTetromino(TetrominoType type, bool unstashing = false);
+	
+	void SettleTetromino(int* score_ = nullptr);
+	
+	void ClearFilledLines();
+};
+
+#endif
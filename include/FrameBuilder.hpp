@@ -0,0 +1,147 @@
+#ifndef FRAME_BUILDER_HPP
+#define FRAME_BUILDER_HPP
+
+#include "Bitboard.hpp"
+#include "PieceState.hpp"
+#include "RenderSnapshot.hpp"
+#include "RotationTables.hpp"
+#include "TetrominoType.hpp"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+// Window position of each board's top-left corner and the size of one cell, in pixels.
+struct FrameLayout
+{
+	int cell_size_;
+	int board_x_;
+	int board_y_;
+	int stash_x_;
+	int stash_y_;
+	int queue_x_;
+	int queue_y_;
+};
+
+struct FrameGroups
+{
+	std::array<std::size_t, rotation_tables::types> fills_;
+	std::array<std::size_t, rotation_tables::types> outlines_;
+	std::size_t grid_;
+};
+
+// Turns a RenderSnapshot into the cell, outline and grid rects of a frame without touching SDL, so
+// Game and the benchmark build frames through the same code. Target is anything with
+// AddRect(std::size_t group, { x, y, w, h }), such as DrawList.
+class FrameBuilder
+{
+private:
+	FrameLayout layout_;
+	FrameGroups groups_;
+
+public:
+	FrameBuilder(const FrameLayout& layout, const FrameGroups& groups) : layout_(layout), groups_(groups)
+	{
+	}
+
+	template <typename Target>
+	void AddBoards(Target& target, const RenderSnapshot& snapshot) const
+	{
+		AddBoardCells(target, snapshot, layout_.board_x_, layout_.board_y_);
+
+		if (snapshot.stashed_type_.has_value())
+		{
+			const int stash_dimension = rotation_tables::dimensions[static_cast<std::size_t>(*snapshot.stashed_type_)];
+			AddGridLines(target, layout_.stash_x_, layout_.stash_y_, stash_dimension, stash_dimension);
+		}
+
+		AddGridLines(target, layout_.board_x_, layout_.board_y_, snapshot.cells_width_, snapshot.cells_height_);
+		AddGridLines(target, layout_.queue_x_, layout_.queue_y_, 4, 12);
+	}
+
+	// remaining is the fraction of the tick still to elapse; the falling piece is drawn that far back
+	// towards previous_piece_.
+	template <typename Target>
+	void AddPieces(Target& target, const RenderSnapshot& snapshot, double remaining) const
+	{
+		const PieceState& piece = snapshot.falling_piece_;
+		const PieceState& previous = snapshot.previous_piece_;
+		const int shift = static_cast<int>((previous.x_ - piece.x_) * remaining * layout_.cell_size_);
+		const int fall_offset = static_cast<int>((previous.y_ - piece.y_) * remaining * layout_.cell_size_);
+
+		AddTetromino(target, piece.type_, piece.rotation_, layout_.board_x_ + shift, layout_.board_y_, piece.x_, piece.y_, piece.y_ + snapshot.falling_drop_distance_, fall_offset);
+
+		if (snapshot.stashed_type_.has_value())
+		{
+			const int y = rotation_tables::spawn_offsets_y[static_cast<std::size_t>(*snapshot.stashed_type_)];
+
+			AddTetromino(target, *snapshot.stashed_type_, 0, layout_.stash_x_, layout_.stash_y_, 0, y, y, 0);
+		}
+
+		for (std::size_t i = 0; i < snapshot.queued_types_.size(); ++i)
+		{
+			const TetrominoType type = snapshot.queued_types_[i];
+			const int y = static_cast<int>(i) * 4 + rotation_tables::spawn_offsets_y[static_cast<std::size_t>(type)];
+
+			AddTetromino(target, type, 0, layout_.queue_x_, layout_.queue_y_, 0, y, y, 0);
+		}
+	}
+
+	template <typename Target>
+	void AddBoardCells(Target& target, const RenderSnapshot& snapshot, int origin_x, int origin_y) const
+	{
+		const int cell_size = layout_.cell_size_;
+
+		for (int y = 0; y < snapshot.cells_height_; ++y)
+		{
+			Bitboard::Row row = snapshot.rows_[y];
+
+			for (int x = 0; row != 0; ++x, row >>= 1)
+			{
+				if (row & 1)
+				{
+					const TetrominoType type = snapshot.cell_types_[y * snapshot.cells_width_ + x];
+					target.AddRect(groups_.fills_[static_cast<std::size_t>(type)], { origin_x + x * cell_size, origin_y + y * cell_size, cell_size, cell_size });
+				}
+			}
+		}
+	}
+
+	template <typename Target>
+	void AddGridLines(Target& target, int origin_x, int origin_y, int cells_width, int cells_height) const
+	{
+		const int cell_size = layout_.cell_size_;
+		const int width = cells_width * cell_size;
+		const int height = cells_height * cell_size;
+
+		for (int i = 1; i < cells_width; ++i)
+		{
+			target.AddRect(groups_.grid_, { origin_x + i * cell_size, origin_y, 1, height + 1 });
+		}
+
+		for (int i = 1; i < cells_height; ++i)
+		{
+			target.AddRect(groups_.grid_, { origin_x, origin_y + i * cell_size, width + 1, 1 });
+		}
+	}
+
+	template <typename Target>
+	void AddTetromino(Target& target, TetrominoType type, int rotation, int origin_x, int origin_y, int x, int y, int ghost_y, int fall_offset) const
+	{
+		const int cell_size = layout_.cell_size_;
+		const std::size_t type_index = static_cast<std::size_t>(type);
+		const rotation_tables::Shape& shape = rotation_tables::shapes[type_index][rotation];
+
+		for (const rotation_tables::Offset& offset : shape)
+		{
+			target.AddRect(groups_.fills_[type_index], { origin_x + (x + offset.x) * cell_size, origin_y + (y + offset.y) * cell_size + fall_offset, cell_size, cell_size });
+		}
+
+		for (const rotation_tables::Offset& offset : shape)
+		{
+			target.AddRect(groups_.outlines_[type_index], { origin_x + (x + offset.x) * cell_size + 1, origin_y + (ghost_y + offset.y) * cell_size + 1, cell_size - 2, cell_size - 2 });
+		}
+	}
+};
+
+#endif
@@ -1,64 +1,123 @@
 #ifndef GAME_HPP
 #define GAME_HPP
 
+#include "BoardLayer.hpp"
+#include "DrawList.hpp"
+#include "Engine.hpp"
+#include "FrameBuilder.hpp"
+#include "GlyphAtlas.hpp"
+#include "Input.hpp"
+#include "PieceSource.hpp"
+#include "PieceState.hpp"
+#include "Profiler.hpp"
+#include "RenderSnapshot.hpp"
+#include "Replay.hpp"
+#include "RotationTables.hpp"
 #include "Texture.hpp"
-#include "Cell.hpp"
-#include "Tetromino.hpp"
+#include "TetrominoType.hpp"
+#include "TripleBuffer.hpp"
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 
-#include <deque>
-#include <random>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
+struct GameOptions
+{
+	std::uint32_t seed_;
+	PieceSourceMode piece_source_mode_;
+	HandlingOptions handling_;
+	int tick_rate_;
+	double time_scale_;
+	int max_catch_up_ticks_;
+	std::string record_path_;
+	std::string replay_path_;
+	bool vsync_;
+	int fps_cap_;
+	bool render_on_change_;
+	bool perf_overlay_;
+	std::string perf_dump_path_;
+};
+
+struct TimedInput
+{
+	std::uint64_t time_;
+	Input input_;
+};
+
 class Game
 {
 private:
-	int ticks_;
-	int moving_ticks_;
+	GameOptions options_;
 	bool initialized_;
-	bool running_;
-	int score_;
-	int lines_;
-	int descend_speed_;
-	bool game_over_;
+	std::atomic<bool> running_;
 	int cell_size_;
-	bool moving_left_;
-	bool moving_right_;
-	bool moving_down_;
-	bool unstash_possible_;
+	bool layers_enabled_;
+	std::uint64_t layered_board_version_;
+	int layered_stash_dimension_;
+	int displayed_score_;
+	int displayed_lines_;
+	std::uint64_t tick_count_;
+	PieceState published_piece_;
+	std::uint64_t published_board_version_;
+	bool interpolating_;
+	std::atomic<bool> replaying_;
+	bool render_requested_;
+	std::array<std::int64_t, 12> last_render_key_;
 
 	SDL_Rect info_viewport_;
 	SDL_Rect board_viewport_;
 	SDL_Rect queue_viewport_;
 
-	std::unique_ptr<Tetromino> stashed_tetromino_;
-	std::unique_ptr<Tetromino> falling_tetromino_;
-	std::vector<std::unique_ptr<Tetromino>> queued_tetrominoes_;
-	std::deque<TetrominoType> tetromino_queue_;
+	SDL_Point stash_position_;
+	SDL_Point queue_position_;
+
+	std::unique_ptr<Engine> engine_;
+	std::unique_ptr<Replay> replay_;
+	std::unique_ptr<TripleBuffer<RenderSnapshot>> snapshots_;
+	const RenderSnapshot* snapshot_;
+	std::thread simulation_thread_;
+	std::uint64_t simulation_start_;
+	Uint32 simulation_start_ms_;
+	std::mutex input_mutex_;
+	std::vector<TimedInput> pending_inputs_;
+	std::vector<TimedInput> applied_inputs_;
+	std::unique_ptr<DrawList> draw_list_;
+	std::unique_ptr<BoardLayer> board_layer_;
+	std::unique_ptr<BoardLayer> stash_layer_;
+	std::unique_ptr<BoardLayer> queue_layer_;
+
+	std::unique_ptr<FrameBuilder> frame_builder_;
+
+	std::unique_ptr<GlyphAtlas> hud_atlas_;
+	std::string score_text_;
+	std::string lines_text_;
 
-	std::unique_ptr<Texture> score_texture_;
-	std::unique_ptr<Texture> lines_texture_;
 	std::unique_ptr<Texture> game_over_texture_;
 	std::unique_ptr<Texture> stash_texture_;
 	std::unique_ptr<Texture> next_texture_;
 
-	std::vector<Cell> stash_board_;
-	std::vector<Cell> queue_board_;
+	std::unique_ptr<Profiler> profiler_;
+	std::unique_ptr<GlyphAtlas> perf_atlas_;
+	std::array<std::string, static_cast<std::size_t>(ProfilePhase::COUNT)> perf_lines_;
+	Uint32 perf_lines_updated_;
+	bool perf_overlay_visible_;
 
 	TTF_Font* font_;
+	TTF_Font* perf_font_;
 	SDL_Window* window_;
-
-public:
-	int cells_width_;
-	int cells_height_;
-
-	std::vector<Cell> board_;
 	SDL_Renderer* renderer_;
 
-	Game();
+public:
+	Game(const GameOptions& options);
 
 	~Game();
 
@@ -67,52 +126,54 @@ public:
 	void Finalize();
 
 	void Run();
+
+	void RunSimulation();
 	
+	void WaitUntil(std::uint64_t performance_counter);
+
+	bool HasVisibleChange();
+
 	void Stop();
 
 	void HandleEvents();
 
+	void ApplyInput(Input input, Uint32 timestamp);
+
+	void ApplyPendingInputs(std::uint64_t tick_time);
+
 	void Tick();
 
+	void PublishSnapshot();
+
 	void Render();
 
-	void InitBoard(std::vector<Cell>* board, std::size_t size, std::size_t width, const SDL_Point& top_left);
-	
-	void InitQueue();
+	bool IsUnlimitedSpeed() const;
 
-	void UpdateQueue();
+	double GetTickPeriod() const;
 
-	void Reset();
+	double GetInterpolation() const;
 
-	void TriggerStashTetromino();
+	std::uint64_t RecordPhase(ProfilePhase phase, std::uint64_t start_counter);
 
-	void RenderFalingTetromino();
-	
-	void RenderStashedTetromino();
-	
-	void RenderQueuedTetrominoes();
+	void RenderPerfOverlay();
 
-	void RenderBoards();
+	void InitDrawList();
 
-	void RenderBoardGridLines(const std::vector<Cell>& board, std::size_t board_cells_width, std::size_t board_cells_height, const SDL_Rect& viewport);
+	bool InitBoardLayers();
 
-	void RenderBoardCells(const std::vector<Cell>& board, const SDL_Rect& viewport);
-	
-	void RenderInfo();
+	void UpdateBoardLayers(int stash_dimension);
 
-	void GenerateTetrominoes();
+	void RenderTetrominoes();
 
-	void SpawnTetromino(TetrominoType type, bool unstashing = false);
-	
-	void SettleTetromino(int* score_ = nullptr);
+	void RenderBoards();
+
+	void RenderLabels();
+
+	void RenderInfo();
 
 	void UpdateScoreText();
 
 	void UpdateLinesText();
-	
-	void ClearFilledLines();
-
-	void DescendUnfilledLines();
 };
 
 #endif
@@ -0,0 +1,82 @@
+#ifndef GAME_SERVER_HPP
+#define GAME_SERVER_HPP
+
+#include "Bot.hpp"
+#include "Engine.hpp"
+#include "Input.hpp"
+#include "PieceSource.hpp"
+#include "ThreadPool.hpp"
+#include "TranspositionTable.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+struct GameServerOptions
+{
+	std::size_t games_;
+	std::uint64_t ticks_;
+	std::uint32_t seed_;
+	std::uint32_t input_seed_;
+	std::size_t threads_;
+	std::uint64_t chunk_ticks_;
+	PieceSourceMode piece_source_mode_;
+	bool bot_;
+	BotOptions bot_options_;
+};
+
+class GameInstance
+{
+private:
+	std::unique_ptr<Engine> engine_;
+	std::mt19937 input_generator_;
+	std::unique_ptr<BotPlayer> bot_player_;
+	std::vector<Input> bot_inputs_;
+	std::uint64_t tick_;
+	std::uint64_t games_;
+	std::uint64_t lines_;
+	std::uint64_t score_;
+
+public:
+	GameInstance(std::uint32_t seed, std::uint32_t input_seed, PieceSourceMode piece_source_mode, const BotOptions* bot_options = nullptr, std::shared_ptr<TranspositionTable> transposition_table = nullptr);
+
+	void Step(std::uint64_t ticks);
+
+	const Engine& GetEngine() const;
+
+	const BotPlayer* GetBotPlayer() const;
+
+	std::uint64_t GetTick() const;
+
+	std::uint64_t GetGames() const;
+
+	std::uint64_t GetLines() const;
+
+	std::uint64_t GetScore() const;
+};
+
+class GameServer
+{
+private:
+	GameServerOptions options_;
+	std::unique_ptr<ThreadPool> thread_pool_;
+	std::shared_ptr<TranspositionTable> transposition_table_;
+	std::vector<std::unique_ptr<GameInstance>> instances_;
+
+	void StepInstance(std::size_t index);
+
+public:
+	GameServer(const GameServerOptions& options);
+
+	void Run();
+
+	const GameInstance& GetInstance(std::size_t index) const;
+
+	std::uint64_t GetCombinedHash() const;
+};
+
+bool ChooseRandomInput(std::mt19937& generator, Input* input);
+
+#endif
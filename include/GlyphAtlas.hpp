@@ -0,0 +1,41 @@
+#ifndef GLYPH_ATLAS_HPP
+#define GLYPH_ATLAS_HPP
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <array>
+#include <vector>
+
+class GlyphAtlas
+{
+private:
+	static constexpr std::size_t max_glyphs = 128;
+
+	SDL_Texture* texture_;
+	int width_;
+	int height_;
+	std::array<SDL_Rect, max_glyphs> glyph_rects_;
+	std::array<bool, max_glyphs> loaded_;
+	std::vector<SDL_Vertex> vertices_;
+	std::vector<int> indices_;
+
+public:
+	GlyphAtlas();
+
+	~GlyphAtlas();
+
+	void FreeTexture();
+
+	bool LoadFromFont(SDL_Renderer* renderer, TTF_Font* font, const char* characters, const SDL_Color& color);
+
+	bool HasGlyphs(const char* text) const;
+
+	int GetTextWidth(const char* text) const;
+
+	int GetHeight() const;
+
+	void Render(SDL_Renderer* renderer, const char* text, int x, int y);
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef HEADLESS_HPP
+#define HEADLESS_HPP
+
+#include "Bot.hpp"
+#include "Engine.hpp"
+#include "Input.hpp"
+#include "PieceSource.hpp"
+#include "Replay.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+struct HeadlessOptions
+{
+	std::uint64_t ticks_;
+	std::uint32_t seed_;
+	std::uint32_t input_seed_;
+	PieceSourceMode piece_source_mode_;
+	bool bot_;
+	BotOptions bot_options_;
+	std::string record_path_;
+	std::string verify_path_;
+};
+
+class Headless
+{
+private:
+	HeadlessOptions options_;
+	std::unique_ptr<Engine> engine_;
+	std::unique_ptr<Replay> replay_;
+	std::unique_ptr<BotPlayer> bot_player_;
+	std::vector<Input> bot_inputs_;
+	std::mt19937 input_generator_;
+	std::uint64_t tick_;
+	std::uint64_t games_;
+
+	void ApplyInput(Input input);
+
+	void ApplyRandomInput();
+
+	void ApplyBotInputs();
+
+public:
+	Headless(const HeadlessOptions& options);
+
+	void Run();
+
+	bool VerifyReplay();
+};
+
+bool ParseBotOption(int argc, char* argv[], int* index, bool* enabled, BotOptions* options);
+
+int RunHeadless(int argc, char* argv[]);
+
+int RunGameServer(int argc, char* argv[]);
+
+int RunTuner(int argc, char* argv[]);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef INPUT_HPP
+#define INPUT_HPP
+
+#include <cstdint>
+
+enum class Input : std::uint8_t
+{
+	ROTATE_CLOCKWISE, 
+	ROTATE_COUNTERCLOCKWISE, 
+	LEFT_PRESS, 
+	LEFT_RELEASE, 
+	RIGHT_PRESS, 
+	RIGHT_RELEASE, 
+	DOWN_PRESS, 
+	DOWN_RELEASE, 
+	HARD_DROP, 
+	STASH, 
+	RESET, 
+	COUNT
+};
+
+#endif
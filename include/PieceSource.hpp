@@ -0,0 +1,72 @@
+#ifndef PIECE_SOURCE_HPP
+#define PIECE_SOURCE_HPP
+
+#include "TetrominoType.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+enum class PieceSourceMode : std::uint8_t
+{
+	SEVEN_BAG,
+	FOURTEEN_BAG,
+	CLASSIC,
+	COUNT
+};
+
+struct PieceSourceState
+{
+	PieceSourceMode mode_;
+	std::uint32_t seed_;
+	std::uint64_t generated_;
+	std::uint64_t consumed_;
+};
+
+class PieceSource
+{
+public:
+	static constexpr std::size_t capacity = 32;
+	static constexpr std::size_t preview = 7;
+
+private:
+	PieceSourceMode mode_;
+	std::uint32_t seed_;
+	std::mt19937 generator_;
+	std::array<TetrominoType, 14> bag_;
+	std::array<TetrominoType, capacity> ring_;
+	std::size_t head_;
+	std::size_t count_;
+	std::uint64_t generated_;
+	std::uint64_t consumed_;
+
+	void Push(TetrominoType type);
+
+	void GenerateBag();
+
+	void Refill();
+
+public:
+	PieceSource(PieceSourceMode mode, std::uint32_t seed);
+
+	PieceSourceMode GetMode() const;
+
+	std::uint32_t GetSeed() const;
+
+	TetrominoType Peek(std::size_t index) const;
+
+	TetrominoType Next();
+
+	void Discard();
+
+	PieceSourceState GetState() const;
+
+	void Restore(const PieceSourceState& state);
+
+	static const char* GetModeName(PieceSourceMode mode);
+
+	static bool ParseMode(const char* name, PieceSourceMode* mode);
+};
+
+#endif
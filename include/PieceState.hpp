@@ -0,0 +1,46 @@
+#ifndef PIECE_STATE_HPP
+#define PIECE_STATE_HPP
+
+#include "Bitboard.hpp"
+#include "RotationTables.hpp"
+#include "TetrominoType.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+struct PieceState
+{
+	TetrominoType type_;
+	std::uint8_t rotation_;
+	std::int16_t x_;
+	std::int16_t y_;
+
+	static PieceState Spawn(TetrominoType type, int x, int y);
+
+	const rotation_tables::Shape& GetShape() const;
+
+	const Bitboard::PieceRows& GetMask() const;
+
+	bool Collides(const Bitboard& bitboard) const;
+
+	int GetDropDistance(const Bitboard& bitboard) const;
+
+	std::optional<PieceState> Moved(const Bitboard& bitboard, int dx) const;
+
+	std::optional<PieceState> Descended(const Bitboard& bitboard) const;
+
+	std::optional<PieceState> Rotated(const Bitboard& bitboard, int degrees) const;
+
+	PieceState Dropped(const Bitboard& bitboard) const;
+
+	void Place(Bitboard* bitboard) const;
+};
+
+static_assert(std::is_trivially_copyable_v<PieceState>);
+
+bool operator==(const PieceState& lhs, const PieceState& rhs);
+
+bool operator!=(const PieceState& lhs, const PieceState& rhs);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class ProfilePhase
+{
+	HANDLE_EVENTS, TICK, RENDER_BOARDS, RENDER_TETROMINOES, RENDER_INFO, RENDER_PRESENT, FRAME, COUNT
+};
+
+struct PhaseStats
+{
+	std::uint64_t count_;
+	double p50_ms_;
+	double p99_ms_;
+	double max_ms_;
+};
+
+class Profiler
+{
+private:
+	struct Histogram
+	{
+		std::vector<double> samples_ms_;
+		std::size_t next_;
+		std::uint64_t count_;
+	};
+
+	std::array<Histogram, static_cast<std::size_t>(ProfilePhase::COUNT)> histograms_;
+	double counter_to_ms_;
+	mutable std::mutex mutex_;
+
+public:
+	static constexpr std::size_t window_size = 600;
+
+	Profiler(std::uint64_t counter_frequency);
+
+	void Record(ProfilePhase phase, std::uint64_t start_counter, std::uint64_t end_counter);
+
+	PhaseStats GetStats(ProfilePhase phase) const;
+
+	static const char* GetPhaseName(ProfilePhase phase);
+
+	bool Dump(const std::string& path) const;
+};
+
+#endif
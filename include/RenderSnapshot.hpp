@@ -0,0 +1,40 @@
+#ifndef RENDER_SNAPSHOT_HPP
+#define RENDER_SNAPSHOT_HPP
+
+#include "Bitboard.hpp"
+#include "Engine.hpp"
+#include "PieceState.hpp"
+#include "TetrominoType.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+// Everything the renderer reads, copied out of the engine at the end of a tick so drawing never
+// touches engine state owned by the simulation thread. previous_piece_ is where the falling piece
+// was drawn from one tick earlier (or the piece itself when it should not be interpolated).
+struct RenderSnapshot
+{
+	static constexpr std::size_t queued = 3;
+
+	std::uint64_t tick_;
+	std::uint64_t published_;
+	std::uint64_t board_version_;
+	int cells_width_;
+	int cells_height_;
+	std::array<Bitboard::Row, Bitboard::max_height> rows_;
+	std::array<TetrominoType, Bitboard::max_width * Bitboard::max_height> cell_types_;
+	PieceState falling_piece_;
+	PieceState previous_piece_;
+	int falling_drop_distance_;
+	std::optional<TetrominoType> stashed_type_;
+	std::array<TetrominoType, queued> queued_types_;
+	int score_;
+	int lines_;
+	bool game_over_;
+
+	void Capture(const Engine& engine, std::uint64_t tick, std::uint64_t published, const PieceState& previous_piece);
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include "Engine.hpp"
+#include "Input.hpp"
+#include "PieceSource.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct ReplayEvent
+{
+	std::uint64_t tick_;
+	Input input_;
+};
+
+class Replay
+{
+private:
+	int cells_width_;
+	int cells_height_;
+	std::uint32_t seed_;
+	PieceSourceMode piece_source_mode_;
+	HandlingOptions handling_;
+	int tick_rate_;
+	std::vector<ReplayEvent> events_;
+	std::uint64_t final_ticks_;
+	int final_score_;
+	int final_lines_;
+	std::uint64_t final_board_hash_;
+	std::size_t next_event_;
+
+public:
+	Replay();
+
+	void Start(const Engine& engine);
+
+	void Record(std::uint64_t tick, Input input);
+
+	void Finish(const Engine& engine, std::uint64_t ticks);
+
+	bool Save(const std::string& path) const;
+
+	bool Load(const std::string& path);
+
+	std::unique_ptr<Engine> CreateEngine() const;
+
+	void ApplyEvents(Engine* engine, std::uint64_t tick);
+
+	bool IsFinished(std::uint64_t tick) const;
+
+	bool Verify(const Engine& engine, std::uint64_t ticks) const;
+
+	std::uint64_t GetFinalTicks() const;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef ROTATION_TABLES_HPP
+#define ROTATION_TABLES_HPP
+
+#include "Bitboard.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace rotation_tables
+{
+	struct Offset
+	{
+		int x;
+		int y;
+	};
+
+	inline constexpr std::size_t types = 7;
+	inline constexpr std::size_t rotations = 4;
+	inline constexpr std::size_t blocks = 4;
+	inline constexpr std::size_t kicks = 5;
+	inline constexpr std::size_t i_type = 0;
+	inline constexpr std::size_t o_type = 3;
+
+	using Shape = std::array<Offset, blocks>;
+	using KickList = std::array<Offset, kicks>;
+
+	// Indexed by TetrominoType: I, J, L, O, S, T, Z.
+	inline constexpr std::array<int, types> dimensions = { 4, 3, 3, 4, 3, 3, 3 };
+
+	inline constexpr std::array<int, types> spawn_offsets_y = { -1, 0, 0, 0, 0, 0, 0 };
+
+	inline constexpr std::array<Shape, types> spawn_shapes = 
+	{{
+		{{ { 0, 1 }, { 1, 1 }, { 2, 1 }, { 3, 1 } }},
+		{{ { 0, 0 }, { 0, 1 }, { 1, 1 }, { 2, 1 } }},
+		{{ { 2, 0 }, { 0, 1 }, { 1, 1 }, { 2, 1 } }},
+		{{ { 1, 0 }, { 2, 0 }, { 1, 1 }, { 2, 1 } }},
+		{{ { 1, 0 }, { 2, 0 }, { 0, 1 }, { 1, 1 } }},
+		{{ { 1, 0 }, { 0, 1 }, { 1, 1 }, { 2, 1 } }},
+		{{ { 0, 0 }, { 1, 0 }, { 1, 1 }, { 2, 1 } }}
+	}};
+
+	// Clockwise SRS kicks from rotation r to r + 1, with y pointing down the board.
+	inline constexpr std::array<KickList, rotations> jlstz_kicks = 
+	{{
+		{{ { 0, 0 }, { -1, 0 }, { -1, -1 }, { 0, 2 }, { -1, 2 } }},
+		{{ { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, -2 }, { 1, -2 } }},
+		{{ { 0, 0 }, { 1, 0 }, { 1, -1 }, { 0, 2 }, { 1, 2 } }},
+		{{ { 0, 0 }, { -1, 0 }, { -1, 1 }, { 0, -2 }, { -1, -2 } }}
+	}};
+
+	inline constexpr std::array<KickList, rotations> i_kicks = 
+	{{
+		{{ { 0, 0 }, { -2, 0 }, { 1, 0 }, { -2, 1 }, { 1, -2 } }},
+		{{ { 0, 0 }, { -1, 0 }, { 2, 0 }, { -1, -2 }, { 2, 1 } }},
+		{{ { 0, 0 }, { 2, 0 }, { -1, 0 }, { 2, -1 }, { -1, 2 } }},
+		{{ { 0, 0 }, { 1, 0 }, { -2, 0 }, { 1, 2 }, { -2, -1 } }}
+	}};
+
+	inline constexpr std::array<KickList, rotations> o_kicks = {};
+
+	constexpr Shape RotateShape(const Shape& shape, int dimension)
+	{
+		Shape rotated = {};
+
+		for (std::size_t i = 0; i < blocks; ++i)
+		{
+			rotated[i] = { dimension - 1 - shape[i].y, shape[i].x };
+		}
+
+		return rotated;
+	}
+
+	constexpr std::array<std::array<Shape, rotations>, types> GenerateShapes()
+	{
+		std::array<std::array<Shape, rotations>, types> generated = {};
+
+		for (std::size_t type = 0; type < types; ++type)
+		{
+			generated[type][0] = spawn_shapes[type];
+
+			for (std::size_t rotation = 1; rotation < rotations; ++rotation)
+			{
+				generated[type][rotation] = type == o_type ? spawn_shapes[type] : RotateShape(generated[type][rotation - 1], dimensions[type]);
+			}
+		}
+
+		return generated;
+	}
+
+	inline constexpr std::array<std::array<Shape, rotations>, types> shapes = GenerateShapes();
+
+	constexpr std::array<std::array<Bitboard::PieceRows, rotations>, types> GenerateMasks()
+	{
+		std::array<std::array<Bitboard::PieceRows, rotations>, types> generated = {};
+
+		for (std::size_t type = 0; type < types; ++type)
+		{
+			for (std::size_t rotation = 0; rotation < rotations; ++rotation)
+			{
+				for (const Offset& offset : shapes[type][rotation])
+				{
+					generated[type][rotation][offset.y] |= static_cast<Bitboard::Row>(1u << offset.x);
+				}
+			}
+		}
+
+		return generated;
+	}
+
+	inline constexpr std::array<std::array<Bitboard::PieceRows, rotations>, types> masks = GenerateMasks();
+
+	// Lowest occupied row of each bounding box column, or -1 when the column is empty.
+	constexpr std::array<std::array<std::array<int, 4>, rotations>, types> GenerateColumnBottoms()
+	{
+		std::array<std::array<std::array<int, 4>, rotations>, types> generated = {};
+
+		for (std::size_t type = 0; type < types; ++type)
+		{
+			for (std::size_t rotation = 0; rotation < rotations; ++rotation)
+			{
+				generated[type][rotation] = { -1, -1, -1, -1 };
+
+				for (const Offset& offset : shapes[type][rotation])
+				{
+					if (offset.y > generated[type][rotation][offset.x])
+					{
+						generated[type][rotation][offset.x] = offset.y;
+					}
+				}
+			}
+		}
+
+		return generated;
+	}
+
+	inline constexpr std::array<std::array<std::array<int, 4>, rotations>, types> column_bottoms = GenerateColumnBottoms();
+
+	constexpr std::array<std::array<KickList, rotations>, types> GenerateKicks()
+	{
+		std::array<std::array<KickList, rotations>, types> generated = {};
+
+		for (std::size_t type = 0; type < types; ++type)
+		{
+			generated[type] = type == i_type ? i_kicks : (type == o_type ? o_kicks : jlstz_kicks);
+		}
+
+		return generated;
+	}
+
+	inline constexpr std::array<std::array<KickList, rotations>, types> clockwise_kicks = GenerateKicks();
+} // namespace rotation_tables
+
+#endif
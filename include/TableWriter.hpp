@@ -0,0 +1,98 @@
+#ifndef TABLE_WRITER_HPP
+#define TABLE_WRITER_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Writes named rows of stats to a file: a JSON object keyed by row name when the path ends in
+// .json, otherwise CSV with a header line. columns[0] names the row name column.
+class TableWriter
+{
+private:
+	std::ofstream file_;
+	bool json_;
+	std::vector<std::string> columns_;
+	std::size_t rows_;
+
+	template <typename T>
+	void WriteValue(std::size_t column, const T& value)
+	{
+		if (json_)
+		{
+			file_ << (column > 1 ? ", \"" : "\"") << columns_[column] << "\": " << value;
+		}
+		else
+		{
+			file_ << ',' << value;
+		}
+	}
+
+public:
+	TableWriter(const std::string& path, std::vector<std::string> columns) : 
+		file_(path, std::ios::trunc), 
+		json_(path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0), 
+		columns_(std::move(columns)), 
+		rows_(0)
+	{
+		if (!file_)
+		{
+			return;
+		}
+
+		if (json_)
+		{
+			file_ << "{\n";
+			return;
+		}
+
+		for (std::size_t i = 0; i < columns_.size(); ++i)
+		{
+			file_ << (i > 0 ? "," : "") << columns_[i];
+		}
+
+		file_ << '\n';
+	}
+
+	bool IsOpen() const
+	{
+		return file_.is_open();
+	}
+
+	template <typename... Values>
+	void AddRow(const std::string& name, const Values&... values)
+	{
+		assert(sizeof...(Values) + 1 == columns_.size());
+
+		if (json_)
+		{
+			file_ << (rows_ > 0 ? ",\n" : "") << "  \"" << name << "\": { ";
+		}
+		else
+		{
+			file_ << name;
+		}
+
+		std::size_t column = 1;
+		(WriteValue(column++, values), ...);
+
+		file_ << (json_ ? " }" : "\n");
+		++rows_;
+	}
+
+	bool Finish()
+	{
+		if (json_)
+		{
+			file_ << (rows_ > 0 ? "\n}\n" : "}\n");
+		}
+
+		file_.flush();
+		return static_cast<bool>(file_);
+	}
+};
+
+#endif
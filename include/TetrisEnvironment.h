@@ -0,0 +1,34 @@
+#ifndef TETRIS_ENVIRONMENT_H
+#define TETRIS_ENVIRONMENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct TetrisEnvironment TetrisEnvironment;
+
+/* No function lets a C++ exception escape: create returns NULL and reset/step return -1 on failure, 0 on success. */
+
+TetrisEnvironment* tetris_environment_create(size_t environments, uint32_t seed, size_t threads, int ticks_per_step);
+
+void tetris_environment_destroy(TetrisEnvironment* environment);
+
+size_t tetris_environment_size(const TetrisEnvironment* environment);
+
+size_t tetris_environment_observation_size(const TetrisEnvironment* environment);
+
+size_t tetris_environment_action_count(void);
+
+int tetris_environment_reset(TetrisEnvironment* environment, uint8_t* observations);
+
+int tetris_environment_step(TetrisEnvironment* environment, const uint8_t* actions, uint8_t* observations, float* rewards, uint8_t* dones);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef TETROMINO_TYPE_HPP
+#define TETROMINO_TYPE_HPP
+
+#include <cstdint>
+
+enum class TetrominoType : std::uint8_t
+{
+	I_BLOCK, J_BLOCK, L_BLOCK, O_BLOCK, S_BLOCK, T_BLOCK, Z_BLOCK
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	using Task = std::function<void()>;
+
+private:
+	struct Worker
+	{
+		std::mutex mutex_;
+		std::deque<Task> tasks_;
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers_;
+	std::vector<std::thread> threads_;
+
+	std::mutex mutex_;
+	std::condition_variable work_available_;
+	std::condition_variable work_done_;
+	std::size_t queued_;
+	std::size_t pending_;
+	bool stopping_;
+
+	std::atomic<std::size_t> next_worker_;
+	std::atomic<std::uint64_t> steals_;
+
+	void WorkerLoop(std::size_t index);
+
+	bool TryPop(std::size_t index, Task* task);
+
+	bool TrySteal(std::size_t index, Task* task);
+
+public:
+	ThreadPool(std::size_t threads = 0);
+
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	std::size_t GetThreadCount() const;
+
+	std::uint64_t GetSteals() const;
+
+	void Submit(Task task);
+
+	void Wait();
+};
+
+#endif
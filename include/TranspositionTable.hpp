@@ -0,0 +1,35 @@
+#ifndef TRANSPOSITION_TABLE_HPP
+#define TRANSPOSITION_TABLE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Fixed-size, always-replace cache of search scores. Each slot stores (key ^ data, data) so a
+// slot torn by concurrent writers fails the key check instead of returning a wrong score.
+class TranspositionTable
+{
+private:
+	struct Entry
+	{
+		std::atomic<std::uint64_t> check_;
+		std::atomic<std::uint64_t> data_;
+	};
+
+	std::unique_ptr<Entry[]> entries_;
+	std::size_t mask_;
+
+public:
+	TranspositionTable(int bits);
+
+	void Clear();
+
+	bool Probe(std::uint64_t key, double* value) const;
+
+	void Store(std::uint64_t key, double value);
+
+	std::size_t GetSize() const;
+};
+
+#endif
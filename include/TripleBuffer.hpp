@@ -0,0 +1,55 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Single-producer, single-consumer handoff of the newest value. The writer fills the back slot
+// and swaps it with the middle one; the reader swaps the middle slot into the front only when the
+// writer has published since. Neither side ever waits, and a slot is never shared while in use.
+template <typename T>
+class TripleBuffer
+{
+private:
+	static constexpr std::uint8_t index_mask = 0x3;
+	static constexpr std::uint8_t fresh_bit = 0x4;
+
+	std::array<T, 3> slots_;
+	std::atomic<std::uint8_t> middle_;
+	std::uint8_t back_;
+	std::uint8_t front_;
+
+public:
+	TripleBuffer() : slots_(), middle_(1), back_(0), front_(2)
+	{
+	}
+
+	T& GetBack()
+	{
+		return slots_[back_];
+	}
+
+	void Publish()
+	{
+		back_ = middle_.exchange(static_cast<std::uint8_t>(back_ | fresh_bit), std::memory_order_acq_rel) & index_mask;
+	}
+
+	bool Update()
+	{
+		if ((middle_.load(std::memory_order_relaxed) & fresh_bit) == 0)
+		{
+			return false;
+		}
+
+		front_ = middle_.exchange(front_, std::memory_order_acq_rel) & index_mask;
+		return true;
+	}
+
+	const T& GetFront() const
+	{
+		return slots_[front_];
+	}
+};
+
+#endif
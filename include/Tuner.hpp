@@ -0,0 +1,83 @@
+#ifndef TUNER_HPP
+#define TUNER_HPP
+
+#include "Bot.hpp"
+#include "PieceSource.hpp"
+#include "ThreadPool.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+struct TunerOptions
+{
+	std::size_t generations_;
+	std::size_t population_;
+	std::size_t games_;
+	std::uint64_t max_pieces_;
+	double elite_fraction_;
+	double initial_deviation_;
+	double noise_;
+	std::uint32_t seed_;
+	std::size_t threads_;
+	PieceSourceMode piece_source_mode_;
+	BotOptions bot_options_;
+	std::string output_path_;
+};
+
+struct TunerGeneration
+{
+	std::size_t games_;
+	double best_fitness_;
+	double mean_fitness_;
+	double elite_fitness_;
+	BotWeights best_weights_;
+	BotWeights mean_weights_;
+	BotWeights deviations_;
+	double seconds_;
+};
+
+class Tuner
+{
+public:
+	static constexpr std::size_t parameters = 6;
+
+	using Vector = std::array<double, parameters>;
+
+private:
+	TunerOptions options_;
+	std::unique_ptr<ThreadPool> thread_pool_;
+	std::mt19937 generator_;
+	Vector mean_;
+	Vector deviations_;
+	std::vector<Vector> candidates_;
+	std::vector<std::uint64_t> lines_;
+	std::vector<std::uint64_t> placements_;
+	std::vector<TunerGeneration> generations_;
+	BotWeights best_weights_;
+	double best_fitness_;
+	std::uint64_t total_placements_;
+
+	std::uint64_t PlayGame(const Vector& weights, std::uint32_t seed, std::uint64_t* placements) const;
+
+public:
+	Tuner(const TunerOptions& options);
+
+	void RunGeneration();
+
+	void Run();
+
+	bool Dump(const std::string& path) const;
+
+	const std::vector<TunerGeneration>& GetGenerations() const;
+
+	const BotWeights& GetBestWeights() const;
+
+	double GetBestFitness() const;
+};
+
+#endif
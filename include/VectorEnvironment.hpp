@@ -0,0 +1,65 @@
+#ifndef VECTOR_ENVIRONMENT_HPP
+#define VECTOR_ENVIRONMENT_HPP
+
+#include "Engine.hpp"
+#include "Input.hpp"
+#include "PieceSource.hpp"
+#include "ThreadPool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+struct VectorEnvironmentOptions
+{
+	std::size_t environments_;
+	std::uint32_t seed_;
+	std::size_t threads_;
+	int ticks_per_step_;
+	PieceSourceMode piece_source_mode_;
+};
+
+// Steps N engines in lockstep. Engines keep their boards inline, so engines_ is one contiguous block.
+// Each observation is laid out as: occupancy plane (width * height), falling piece plane (width * height), then
+// falling type + 1, falling rotation, preview types + 1, stashed type + 1 (0 if empty), can stash.
+// Actions are the Input values below RESET, then no_action; finished games reset themselves, so a
+// policy cannot end an episode early.
+class VectorEnvironment
+{
+public:
+	static_assert(static_cast<std::size_t>(Input::RESET) + 1 == static_cast<std::size_t>(Input::COUNT), "RESET must be the last input");
+
+	static constexpr std::size_t preview = PieceSource::preview;
+	static constexpr std::uint8_t no_action = static_cast<std::uint8_t>(Input::RESET);
+	static constexpr std::size_t action_count = static_cast<std::size_t>(no_action) + 1;
+
+private:
+	VectorEnvironmentOptions options_;
+	std::vector<Engine> engines_;
+	std::unique_ptr<ThreadPool> thread_pool_;
+	std::size_t plane_size_;
+	std::size_t observation_size_;
+
+	void StepRange(std::size_t first, std::size_t last, const std::uint8_t* actions, std::uint8_t* observations, float* rewards, std::uint8_t* dones);
+
+	void WriteObservation(std::size_t index, std::uint8_t* observation) const;
+
+	void ForEachRange(const std::function<void(std::size_t, std::size_t)>& function);
+
+public:
+	VectorEnvironment(const VectorEnvironmentOptions& options);
+
+	std::size_t GetSize() const;
+
+	std::size_t GetObservationSize() const;
+
+	const Engine& GetEngine(std::size_t index) const;
+
+	void Reset(std::uint8_t* observations);
+
+	void Step(const std::uint8_t* actions, std::uint8_t* observations, float* rewards, std::uint8_t* dones);
+};
+
+#endif
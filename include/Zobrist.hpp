@@ -0,0 +1,33 @@
+#ifndef ZOBRIST_HPP
+#define ZOBRIST_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace zobrist
+{
+	// SplitMix64 finaliser, so the key tables are fixed at compile time and identical across runs.
+	constexpr std::uint64_t Mix(std::uint64_t value)
+	{
+		value += 0x9e3779b97f4a7c15ull;
+		value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+		value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+		return value ^ (value >> 31);
+	}
+
+	template <std::size_t N>
+	constexpr std::array<std::uint64_t, N> MakeKeys(std::uint64_t salt)
+	{
+		std::array<std::uint64_t, N> keys = {};
+
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			keys[i] = Mix(salt * N + i);
+		}
+
+		return keys;
+	}
+}
+
+#endif
@@ -0,0 +1,82 @@
+#include "BoardLayer.hpp"
+
+#include <SDL2/SDL.h>
+
+#include <cassert>
+
+BoardLayer::BoardLayer() : texture_(nullptr), width_(0), height_(0), dirty_(true)
+{
+}
+
+BoardLayer::~BoardLayer()
+{
+	FreeTexture();
+}
+
+void BoardLayer::FreeTexture()
+{
+	if (texture_ != nullptr)
+	{
+		SDL_DestroyTexture(texture_);
+		texture_ = nullptr;
+		width_ = 0;
+		height_ = 0;
+	}
+
+	dirty_ = true;
+}
+
+bool BoardLayer::Create(SDL_Renderer* renderer, int width, int height)
+{
+	FreeTexture();
+
+	texture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+
+	if (texture_ == nullptr)
+	{
+		printf("Unable to create board layer texture! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
+	width_ = width;
+	height_ = height;
+	return true;
+}
+
+void BoardLayer::MarkDirty()
+{
+	dirty_ = true;
+}
+
+bool BoardLayer::IsDirty() const
+{
+	return dirty_;
+}
+
+void BoardLayer::BeginRedraw(SDL_Renderer* renderer)
+{
+	assert(texture_ != nullptr);
+
+	SDL_SetRenderTarget(renderer, texture_);
+	SDL_RenderSetViewport(renderer, NULL);
+	SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0x00);
+	SDL_RenderClear(renderer);
+}
+
+void BoardLayer::EndRedraw(SDL_Renderer* renderer)
+{
+	SDL_SetRenderTarget(renderer, NULL);
+	dirty_ = false;
+}
+
+void BoardLayer::Render(SDL_Renderer* renderer, int x, int y)
+{
+	if (texture_ == nullptr)
+	{
+		return;
+	}
+
+	const SDL_Rect render_rect = { x, y, width_, height_ };
+	SDL_RenderCopy(renderer, texture_, nullptr, &render_rect);
+}
@@ -0,0 +1,51 @@
+#include "DrawList.hpp"
+
+#include <SDL2/SDL.h>
+
+#include <cassert>
+
+std::size_t DrawList::AddGroup(const SDL_Color& color, Mode mode)
+{
+	groups_.push_back({ color, mode, {} });
+	return groups_.size() - 1;
+}
+
+void DrawList::AddRect(std::size_t group, const SDL_Rect& rect)
+{
+	assert(group < groups_.size());
+	groups_[group].rects_.push_back(rect);
+}
+
+void DrawList::Submit(SDL_Renderer* renderer)
+{
+	SDL_RenderSetViewport(renderer, NULL);
+
+	for (Group& group : groups_)
+	{
+		if (group.rects_.empty())
+		{
+			continue;
+		}
+
+		SDL_SetRenderDrawColor(renderer, group.color_.r, group.color_.g, group.color_.b, group.color_.a);
+
+		if (group.mode_ == Mode::FILL)
+		{
+			SDL_RenderFillRects(renderer, group.rects_.data(), static_cast<int>(group.rects_.size()));
+		}
+		else
+		{
+			SDL_RenderDrawRects(renderer, group.rects_.data(), static_cast<int>(group.rects_.size()));
+		}
+	}
+
+	Clear();
+}
+
+void DrawList::Clear()
+{
+	for (Group& group : groups_)
+	{
+		group.rects_.clear();
+	}
+}
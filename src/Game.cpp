@@ -1,44 +1,88 @@
 #include "Constants.hpp"
 #include "Game.hpp"
-#include "Tetromino.hpp"
+#include "RotationTables.hpp"
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <string>
-#include <deque>
-#include <iostream>
-#include <random>
-#include <vector>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <cassert>
 
-Game::Game() : 
-	ticks_(0), 
-	moving_ticks_(0), 
+namespace
+{
+	constexpr SDL_Color tetromino_colors[rotation_tables::types] = 
+	{
+		{ 0x00, 0xff, 0xff, 0xff }, 
+		{ 0x00, 0x00, 0xff, 0xff }, 
+		{ 0xff, 0xaa, 0x00, 0xff }, 
+		{ 0xff, 0xff, 0x00, 0xff }, 
+		{ 0x00, 0xff, 0x00, 0xff }, 
+		{ 0x99, 0x00, 0xff, 0xff }, 
+		{ 0xff, 0x00, 0x00, 0xff }
+	};
+
+	constexpr int preview_frame_rate = 10;
+
+	constexpr const char* hud_digits = "0123456789";
+	constexpr const char* score_label = "Score: ";
+	constexpr const char* lines_label = "Lines: ";
+}
+
+Game::Game(const GameOptions& options) : 
+	options_(options), 
 	initialized_(false), 
 	running_(false), 
-	score_(0), 
-	lines_(0), 
-	descend_speed_(60), 
-	game_over_(false), 
-	cell_size_(32), 
-	moving_left_(false), 
-	moving_right_(false), 
-	moving_down_(false), 
-	unstash_possible_(false), 
-	stashed_tetromino_(nullptr), 
-	falling_tetromino_(std::make_unique<Tetromino>(this)), 
-	score_texture_(std::make_unique<Texture>()), 
-	lines_texture_(std::make_unique<Texture>()), 
+	cell_size_(constants::cell_size), 
+	layers_enabled_(false), 
+	layered_board_version_(0), 
+	layered_stash_dimension_(0), 
+	displayed_score_(0), 
+	displayed_lines_(0), 
+	tick_count_(0), 
+	published_piece_(), 
+	published_board_version_(0), 
+	interpolating_(false), 
+	replaying_(false), 
+	render_requested_(true), 
+	last_render_key_(), 
+	stash_position_({ 96, 160 }), 
+	queue_position_({ 96, 160 }), 
+	engine_(nullptr), 
+	replay_(nullptr), 
+	snapshots_(std::make_unique<TripleBuffer<RenderSnapshot>>()), 
+	snapshot_(nullptr), 
+	simulation_thread_(), 
+	simulation_start_(0), 
+	simulation_start_ms_(0), 
+	input_mutex_(), 
+	pending_inputs_(), 
+	applied_inputs_(), 
+	draw_list_(std::make_unique<DrawList>()), 
+	board_layer_(std::make_unique<BoardLayer>()), 
+	stash_layer_(std::make_unique<BoardLayer>()), 
+	queue_layer_(std::make_unique<BoardLayer>()), 
+	frame_builder_(nullptr), 
+	hud_atlas_(std::make_unique<GlyphAtlas>()), 
+	score_text_(), 
+	lines_text_(), 
 	game_over_texture_(std::make_unique<Texture>()), 
 	stash_texture_(std::make_unique<Texture>()), 
 	next_texture_(std::make_unique<Texture>()), 
+	profiler_(std::make_unique<Profiler>(SDL_GetPerformanceFrequency())), 
+	perf_atlas_(std::make_unique<GlyphAtlas>()), 
+	perf_lines_(), 
+	perf_lines_updated_(0), 
+	perf_overlay_visible_(options.perf_overlay_), 
 	font_(nullptr), 
+	perf_font_(nullptr), 
 	window_(nullptr), 
-	cells_width_(0), 
-	cells_height_(0), 
 	renderer_(nullptr)
 {
 	initialized_ = Initialize();
@@ -63,26 +107,83 @@ Game::Game() :
 	queue_viewport_.w = constants::screen_width / 3;
 	queue_viewport_.h = constants::screen_height;
 
-	cells_width_ = (board_viewport_.w / cell_size_);
-	cells_height_ = (board_viewport_.h / cell_size_);
+	engine_ = std::make_unique<Engine>(board_viewport_.w / cell_size_, board_viewport_.h / cell_size_, options_.seed_, options_.piece_source_mode_);
+	engine_->SetHandling(options_.handling_);
+	engine_->SetTickRate(options_.tick_rate_);
+	options_.tick_rate_ = engine_->GetTickRate();
+
+	if (!options_.replay_path_.empty())
+	{
+		replay_ = std::make_unique<Replay>();
+		replaying_ = replay_->Load(options_.replay_path_);
+
+		if (replaying_)
+		{
+			engine_ = replay_->CreateEngine();
+			options_.tick_rate_ = engine_->GetTickRate();
+		}
+		else
+		{
+			replay_.reset();
+		}
+	}
+	else if (!options_.record_path_.empty())
+	{
+		replay_ = std::make_unique<Replay>();
+		replay_->Start(*engine_);
+	}
+
+	if (options_.max_catch_up_ticks_ <= 0)
+	{
+		options_.max_catch_up_ticks_ = std::max(1, options_.tick_rate_ / 4);
+	}
+
+	published_piece_ = engine_->GetFallingPiece();
+	published_board_version_ = engine_->GetBoardVersion();
+
+	PublishSnapshot();
+	snapshots_->Update();
+	snapshot_ = &snapshots_->GetFront();
+
+	InitDrawList();
+	layers_enabled_ = InitBoardLayers();
 
+	const std::string hud_characters = std::string(hud_digits) + score_label + lines_label;
+
+	if (!hud_atlas_->LoadFromFont(renderer_, font_, hud_characters.c_str(), { 0xff, 0xff, 0xff, 0xff }))
+	{
+		printf("Unable to load the HUD glyph atlas!\n");
+	}
+
+	std::string printable_characters;
+
+	for (char c = ' '; c <= '~'; ++c)
+	{
+		printable_characters.push_back(c);
+	}
+
+	perf_atlas_->LoadFromFont(renderer_, perf_font_, printable_characters.c_str(), { 0xff, 0xff, 0x00, 0xff });
 	UpdateScoreText();
 	UpdateLinesText();
 
 	game_over_texture_->LoadFromText(renderer_, font_, "Game Over! Press 'r' to reset.", { 0xff, 0x00, 0x00, 0xff }, 200);
 	stash_texture_->LoadFromText(renderer_, font_, "Stash", { 0xff, 0xff, 0xff, 0xff });
 	next_texture_->LoadFromText(renderer_, font_, "Next", { 0xff, 0xff, 0xff, 0xff });
-
-	InitBoard(&board_, cells_width_ * cells_height_, cells_width_, { 0, 0 });
-	GenerateTetrominoes();
-	SpawnTetromino(tetromino_queue_.front());
-	InitBoard(&stash_board_, falling_tetromino_->GetBBoxSize(), falling_tetromino_->GetBBoxDimension(), { 96, 160 });
-	InitQueue();	
-	UpdateQueue();
 }
 
 Game::~Game()
 {
+	if (!options_.perf_dump_path_.empty())
+	{
+		profiler_->Dump(options_.perf_dump_path_);
+	}
+
+	if (replay_ != nullptr && !replaying_ && engine_ != nullptr)
+	{
+		replay_->Finish(*engine_, tick_count_);
+		replay_->Save(options_.record_path_);
+	}
+
 	Finalize();
 }
 
@@ -107,7 +208,8 @@ bool Game::Initialize()
 		return false;
 	}
 
-	renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED);
+	const Uint32 renderer_flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE | (options_.vsync_ ? SDL_RENDERER_PRESENTVSYNC : 0);
+	renderer_ = SDL_CreateRenderer(window_, -1, renderer_flags);
 
 	if (renderer_ == nullptr)
 	{
@@ -130,8 +232,9 @@ bool Game::Initialize()
 	}
 	
 	font_ = TTF_OpenFont("res/font/font.ttf", 38);
+	perf_font_ = TTF_OpenFont("res/font/font.ttf", 14);
 
-	if (font_ == nullptr)
+	if (font_ == nullptr || perf_font_ == nullptr)
 	{
 		printf("Failed to load font! SDL_ttf Error: %s\n", TTF_GetError());
 		return false;
@@ -151,6 +254,9 @@ void Game::Finalize()
 	TTF_CloseFont(font_);
 	font_ = nullptr;
 
+	TTF_CloseFont(perf_font_);
+	perf_font_ = nullptr;
+
 	SDL_Quit();
 	IMG_Quit();
 	TTF_Quit();
@@ -164,45 +270,144 @@ void Game::Run()
 	}
 
 	running_ = true;
+	simulation_start_ = SDL_GetPerformanceCounter();
+	simulation_start_ms_ = SDL_GetTicks();
+	simulation_thread_ = std::thread(&Game::RunSimulation, this);
 
-	constexpr long double ms = 1.0 / 60.0;
-	std::uint64_t last_time = SDL_GetPerformanceCounter();
-	long double delta = 0.0;
-
-	double timer = SDL_GetTicks();
-
-	int frames = 0;
-	int ticks = 0;
+	const int fps_cap = IsUnlimitedSpeed() ? preview_frame_rate : options_.fps_cap_;
+	std::uint64_t next_frame_time = SDL_GetPerformanceCounter();
 
 	while (running_)
 	{
 		const std::uint64_t now = SDL_GetPerformanceCounter();
-		const long double elapsed = static_cast<long double>(now - last_time) / static_cast<long double>(SDL_GetPerformanceFrequency());
-
-		last_time = now;
-		delta += elapsed;
 
 		HandleEvents();
+		RecordPhase(ProfilePhase::HANDLE_EVENTS, now);
 
-		while (delta >= ms)
+		snapshots_->Update();
+		snapshot_ = &snapshots_->GetFront();
+
+		if (!options_.render_on_change_ || render_requested_ || HasVisibleChange())
+		{
+			Render();
+			RecordPhase(ProfilePhase::FRAME, now);
+			render_requested_ = false;
+
+			if (fps_cap > 0)
+			{
+				const std::uint64_t frame_period = SDL_GetPerformanceFrequency() / static_cast<std::uint64_t>(fps_cap);
+				const std::uint64_t frame_end = SDL_GetPerformanceCounter();
+
+				next_frame_time = next_frame_time + frame_period < frame_end ? frame_end : next_frame_time + frame_period;
+				WaitUntil(next_frame_time);
+			}
+		}
+		else
+		{
+			// Nothing to draw until the simulation publishes its next snapshot or an event arrives.
+			const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+			const double snapshot_period = IsUnlimitedSpeed() ? frequency / preview_frame_rate : GetTickPeriod();
+			const double wait_ms = (static_cast<double>(snapshot_->published_) + snapshot_period - static_cast<double>(SDL_GetPerformanceCounter())) * 1000.0 / frequency;
+
+			SDL_WaitEventTimeout(nullptr, std::max(1, static_cast<int>(std::ceil(wait_ms))));
+		}
+	}
+
+	simulation_thread_.join();
+}
+
+void Game::RunSimulation()
+{
+	const bool unlimited = IsUnlimitedSpeed();
+	const double tick_period = GetTickPeriod();
+	double tick_time = static_cast<double>(simulation_start_);
+	int catch_up_ticks = 0;
+
+	while (running_)
+	{
+		const std::uint64_t tick_start = SDL_GetPerformanceCounter();
+
+		ApplyPendingInputs(unlimited ? tick_start : static_cast<std::uint64_t>(tick_time));
+		Tick();
+		PublishSnapshot();
+		RecordPhase(ProfilePhase::TICK, tick_start);
+
+		if (unlimited)
 		{
-			Tick();
-			delta -= ms;
-			++ticks;
+			continue;
 		}
 
-		//printf("%Lf\n", delta / ms);
-		Render();
-		++frames;
+		tick_time += tick_period;
+
+		const std::uint64_t now = SDL_GetPerformanceCounter();
 
-		if (SDL_GetTicks() - timer > 1000)
+		if (tick_time > static_cast<double>(now))
 		{
-			timer += 1000;
-			//printf("Frames: %d, Ticks: %d\n", frames, ticks);
-			frames = 0;
-			ticks = 0;
+			catch_up_ticks = 0;
+			WaitUntil(static_cast<std::uint64_t>(tick_time));
 		}
+		else if (++catch_up_ticks >= options_.max_catch_up_ticks_)
+		{
+			// Too far behind to catch up without starving the renderer; drop the backlog instead.
+			catch_up_ticks = 0;
+			tick_time = static_cast<double>(now);
+		}
+	}
+}
+
+void Game::WaitUntil(std::uint64_t performance_counter)
+{
+	const std::uint64_t frequency = SDL_GetPerformanceFrequency();
+	const std::uint64_t spin_threshold = frequency / 500;
+
+	std::uint64_t now = SDL_GetPerformanceCounter();
+
+	while (now + spin_threshold < performance_counter)
+	{
+		const std::uint64_t sleep_ms = (performance_counter - now - spin_threshold) * 1000 / frequency;
+		SDL_Delay(static_cast<Uint32>(sleep_ms > 0 ? sleep_ms : 1));
+		now = SDL_GetPerformanceCounter();
+	}
+
+	while (now < performance_counter)
+	{
+		now = SDL_GetPerformanceCounter();
+	}
+}
+
+bool Game::HasVisibleChange()
+{
+	if (interpolating_)
+	{
+		return true;
+	}
+
+	const PieceState& piece = snapshot_->falling_piece_;
+	const std::optional<TetrominoType>& stashed_type = snapshot_->stashed_type_;
+
+	const std::array<std::int64_t, 12> render_key = 
+	{
+		static_cast<std::int64_t>(piece.type_), 
+		piece.rotation_, 
+		piece.x_, 
+		piece.y_, 
+		static_cast<std::int64_t>(snapshot_->board_version_), 
+		stashed_type.has_value() ? static_cast<std::int64_t>(*stashed_type) : -1, 
+		static_cast<std::int64_t>(snapshot_->queued_types_[0]), 
+		static_cast<std::int64_t>(snapshot_->queued_types_[1]), 
+		static_cast<std::int64_t>(snapshot_->queued_types_[2]), 
+		snapshot_->score_, 
+		snapshot_->lines_, 
+		snapshot_->game_over_
+	};
+
+	if (render_key == last_render_key_)
+	{
+		return false;
 	}
+
+	last_render_key_ = render_key;
+	return true;
 }
 
 void Game::Stop()
@@ -221,540 +426,418 @@ void Game::HandleEvents()
 			Stop();
 			return;
 		}
+
+		if (e.type == SDL_WINDOWEVENT)
+		{
+			render_requested_ = true;
+		}
+
+		if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F3 && e.key.repeat == 0)
+		{
+			perf_overlay_visible_ = !perf_overlay_visible_;
+			render_requested_ = true;
+		}
+
+		if (layers_enabled_ && (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET))
+		{
+			layers_enabled_ = InitBoardLayers();
+		}
+		
+		if (replaying_)
+		{
+			continue;
+		}
 		
-		if (game_over_ && e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_r)
+		if (snapshot_->game_over_ && e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_r)
 		{
-			Reset();
+			ApplyInput(Input::RESET, e.key.timestamp);
 		}
 
-		if (!game_over_ && e.type == SDL_KEYDOWN)
+		if (!snapshot_->game_over_ && e.type == SDL_KEYDOWN && e.key.repeat == 0)
 		{
 			if (e.key.keysym.sym == SDLK_UP)
 			{
-				falling_tetromino_->RotateTetromino(90);
+				ApplyInput(Input::ROTATE_CLOCKWISE, e.key.timestamp);
 			}
 
 			if (e.key.keysym.sym == SDLK_LEFT)
 			{
-				moving_left_ = true;
+				ApplyInput(Input::LEFT_PRESS, e.key.timestamp);
 			}
 			else if (e.key.keysym.sym == SDLK_RIGHT)
 			{
-				moving_right_ = true;
+				ApplyInput(Input::RIGHT_PRESS, e.key.timestamp);
 			}
 			
 			if (e.key.keysym.sym == SDLK_DOWN)
 			{
-				moving_down_ = true;
+				ApplyInput(Input::DOWN_PRESS, e.key.timestamp);
 			}
 			
 			if (e.key.keysym.sym == SDLK_SPACE)
 			{
-				SettleTetromino(&score_);
+				ApplyInput(Input::HARD_DROP, e.key.timestamp);
 			}
 			else if (e.key.keysym.sym == SDLK_c)
 			{
-				TriggerStashTetromino();
+				ApplyInput(Input::STASH, e.key.timestamp);
 			}
 		}
-		else if (!game_over_ && e.type == SDL_KEYUP)
+		else if (!snapshot_->game_over_ && e.type == SDL_KEYUP)
 		{
 			if (e.key.keysym.sym == SDLK_LEFT)
 			{
-				moving_left_ = false;
-				moving_ticks_ = 0;
+				ApplyInput(Input::LEFT_RELEASE, e.key.timestamp);
 			}
 			else if (e.key.keysym.sym == SDLK_RIGHT)
 			{
-				moving_right_ = false;
-				moving_ticks_ = 0;
+				ApplyInput(Input::RIGHT_RELEASE, e.key.timestamp);
 			}
 			
 			if (e.key.keysym.sym == SDLK_DOWN)
 			{
-				moving_down_ = false;
-				moving_ticks_ = 0;
+				ApplyInput(Input::DOWN_RELEASE, e.key.timestamp);
 			}
 		}
 	}
 }
 
-void Game::Tick()
+void Game::ApplyInput(Input input, Uint32 timestamp)
 {
-	if (game_over_)
-	{
-		return;
-	}
+	const std::uint64_t elapsed_ms = timestamp > simulation_start_ms_ ? timestamp - simulation_start_ms_ : 0;
+	const std::uint64_t time = simulation_start_ + elapsed_ms * SDL_GetPerformanceFrequency() / 1000;
 
-	++ticks_;
+	const std::lock_guard<std::mutex> lock(input_mutex_);
+	pending_inputs_.push_back({ time, input });
+}
 
-	if (ticks_ % descend_speed_ == 0)
+void Game::ApplyPendingInputs(std::uint64_t tick_time)
+{
 	{
-		if (!moving_down_ && !falling_tetromino_->DescendTetromino())
+		const std::lock_guard<std::mutex> lock(input_mutex_);
+		const auto first_pending = std::find_if(pending_inputs_.begin(), pending_inputs_.end(), [tick_time](const TimedInput& event)
 		{
-			SettleTetromino();
-		}
+			return event.time_ > tick_time;
+		});
+
+		applied_inputs_.assign(pending_inputs_.begin(), first_pending);
+		pending_inputs_.erase(pending_inputs_.begin(), first_pending);
 	}
 
-	if (moving_left_ || moving_right_ || moving_down_)
+	for (const TimedInput& event : applied_inputs_)
 	{
-		if (moving_ticks_ % 5 == 0)
+		if (replay_ != nullptr)
 		{
-			if (moving_left_)
-			{
-				falling_tetromino_->MoveTetromino(false);
-			}
-			else if (moving_right_)
-			{
-				falling_tetromino_->MoveTetromino(true);
-			}
-			
-			if (moving_down_)
-			{
-				if (!falling_tetromino_->DescendTetromino(&score_))
-				{
-					SettleTetromino();
-				}
-			}
+			replay_->Record(tick_count_, event.input_);
 		}
 
-		++moving_ticks_;
+		engine_->ApplyInput(event.input_);
 	}
-
-	UpdateScoreText();
 }
 
-void Game::Render()
-{
-	SDL_RenderSetViewport(renderer_, NULL);
-	SDL_SetRenderDrawColor(renderer_, 0x00, 0x00, 0x00, 0xff);
-	SDL_RenderClear(renderer_);
-
-	RenderFalingTetromino();
-	RenderStashedTetromino();
-	RenderQueuedTetrominoes();
-
-	RenderBoards();
-	RenderInfo();
-
-	SDL_RenderPresent(renderer_);
-}
-
-void Game::InitBoard(std::vector<Cell>* board, std::size_t size, std::size_t width, const SDL_Point& top_left)
+void Game::Tick()
 {
-	assert(board != nullptr);
-
-	board->clear();
-	board->resize(size, this);
-
-	int rect_x = top_left.x;
-	int rect_y = top_left.y;
-
-	for (std::size_t i = 0; i < board->size(); ++i)
+	if (replaying_)
 	{
-		(*board)[i].rect_.x = rect_x;
-		(*board)[i].rect_.y = rect_y;
-		(*board)[i].rect_.w = cell_size_;
-		(*board)[i].rect_.h = (*board)[i].rect_.w;
+		replay_->ApplyEvents(engine_.get(), tick_count_);
 
-		if ((i + 1) % width == 0)
-		{
-			rect_x = top_left.x;
-			rect_y += cell_size_;
-		}
-		else
+		if (replay_->IsFinished(tick_count_))
 		{
-			rect_x += cell_size_;
+			replay_->Verify(*engine_, tick_count_);
+			replaying_ = false;
+			replay_.reset();
+			return;
 		}
 	}
-}
 
-void Game::InitQueue()
-{
-	InitBoard(&queue_board_, 48, 4, { 96, 160 });
-	queued_tetrominoes_.resize(3);
-	queued_tetrominoes_[0] = std::make_unique<Tetromino>(this);
-	queued_tetrominoes_[1] = std::make_unique<Tetromino>(this);
-	queued_tetrominoes_[2] = std::make_unique<Tetromino>(this);
+	engine_->Tick();
+	++tick_count_;
 }
 
-void Game::UpdateQueue()
+void Game::PublishSnapshot()
 {
-	assert(!tetromino_queue_.empty());
-	std::vector<Cell*> bbox;
+	const PieceState& piece = engine_->GetFallingPiece();
+	const int dx = piece.x_ - published_piece_.x_;
+	const int dy = piece.y_ - published_piece_.y_;
 
-	for (std::size_t ti = 0; ti < 3; ++ti)
-	{
-		std::size_t dimension = (tetromino_queue_[ti] == TetrominoType::I_BLOCK || tetromino_queue_[ti] == TetrominoType::O_BLOCK) ? 4 : 3;
-		std::size_t start_index = ti * 16;
-		std::size_t index = ti * 16;
+	// Only single-cell steps of the same piece glide; spawns, rotations and instant moves snap.
+	const bool glides = engine_->GetBoardVersion() == published_board_version_ 
+		&& piece.type_ == published_piece_.type_ 
+		&& piece.rotation_ == published_piece_.rotation_ 
+		&& dx >= -1 && dx <= 1 && dy >= 0 && dy <= 1;
 
-		for (std::size_t i = 0; i < dimension * dimension; ++i)
-		{
-			bbox.emplace_back(&queue_board_[index++]);
+	snapshots_->GetBack().Capture(*engine_, tick_count_, SDL_GetPerformanceCounter(), glides ? published_piece_ : piece);
+	snapshots_->Publish();
 
-			if (dimension == 3 && ((index - start_index) == 3 || (index - start_index) == 7 || (index - start_index) == 11))
-			{
-				index++;
-			}
-		}
-
-		queued_tetrominoes_[ti]->Initialize(bbox, tetromino_queue_[ti]);
-		bbox.clear();
-	}
+	published_piece_ = piece;
+	published_board_version_ = engine_->GetBoardVersion();
 }
 
-void Game::Reset()
+void Game::Render()
 {
-	stash_board_.clear();
-	stashed_tetromino_.reset();
-	stashed_tetromino_ = nullptr;
+	std::uint64_t phase_start = SDL_GetPerformanceCounter();
 
-	for (Cell& cell : board_)
+	if (displayed_score_ != snapshot_->score_)
 	{
-		cell.color_ = { 0x00, 0x00, 0x00, 0xff };
-		cell.occupied_ = false;
+		UpdateScoreText();
 	}
 
-	for (Cell& cell : queue_board_)
+	if (displayed_lines_ != snapshot_->lines_)
 	{
-		cell.color_ = { 0x00, 0x00, 0x00, 0xff };
-		cell.occupied_ = false;
+		UpdateLinesText();
 	}
 
-	tetromino_queue_.clear();
-	GenerateTetrominoes();
-	UpdateQueue();
-
-	score_ = 0;
-	lines_ = 0;
-	descend_speed_ = 60;
-	moving_left_ = false;
-	moving_right_ = false;
-	moving_down_ = false;
-	game_over_ = false;
-}
+	const std::optional<TetrominoType>& stashed_type = snapshot_->stashed_type_;
+	const int stash_dimension = stashed_type.has_value() ? rotation_tables::dimensions[static_cast<std::size_t>(*stashed_type)] : 0;
 
-void Game::TriggerStashTetromino()
-{
-	if (stashed_tetromino_ == nullptr || unstash_possible_)
+	if (layers_enabled_)
 	{
-		InitBoard(&stash_board_, falling_tetromino_->GetBBoxSize(), falling_tetromino_->GetBBoxDimension(), { 96, 160 });
+		UpdateBoardLayers(stash_dimension);
+	}
 
-		std::vector<Cell*> bbox;
+	SDL_RenderSetViewport(renderer_, NULL);
+	SDL_SetRenderDrawColor(renderer_, 0x00, 0x00, 0x00, 0xff);
+	SDL_RenderClear(renderer_);
 
-		for (std::size_t i = 0; i < stash_board_.size(); ++i)
-		{
-			bbox.emplace_back(&stash_board_[i]);
-		}
+	RenderBoards();
+	phase_start = RecordPhase(ProfilePhase::RENDER_BOARDS, phase_start);
 
-		if (unstash_possible_)
-		{
-			TetrominoType stashed_type = stashed_tetromino_->GetType();
-			stashed_tetromino_->Initialize(bbox, falling_tetromino_->GetType());
-			unstash_possible_ = false;
-			SpawnTetromino(stashed_type, true);
-		}
+	RenderTetrominoes();
 
-		if (stashed_tetromino_ == nullptr)
-		{
-			stashed_tetromino_ = std::make_unique<Tetromino>(this);
-			stashed_tetromino_->Initialize(bbox, falling_tetromino_->GetType());
-			unstash_possible_ = false;
-			SpawnTetromino(tetromino_queue_.front());
-			UpdateQueue();
-		}
-	}
+	draw_list_->Submit(renderer_);
+	phase_start = RecordPhase(ProfilePhase::RENDER_TETROMINOES, phase_start);
+
+	RenderLabels();
+	RenderInfo();
+	RenderPerfOverlay();
+	phase_start = RecordPhase(ProfilePhase::RENDER_INFO, phase_start);
+
+	SDL_RenderPresent(renderer_);
+	RecordPhase(ProfilePhase::RENDER_PRESENT, phase_start);
 }
 
-void Game::RenderFalingTetromino()
+bool Game::IsUnlimitedSpeed() const
 {
-	SDL_RenderSetViewport(renderer_, &board_viewport_);
-	falling_tetromino_->Render();
-	SDL_RenderSetViewport(renderer_, NULL);
+	return options_.time_scale_ <= 0.0;
 }
 
-void Game::RenderStashedTetromino()
+double Game::GetTickPeriod() const
 {
-	if (stashed_tetromino_ != nullptr)
-	{
-		SDL_RenderSetViewport(renderer_, &info_viewport_);
-		stashed_tetromino_->Render();
-		SDL_RenderSetViewport(renderer_, NULL);
-	}
+	return IsUnlimitedSpeed() ? 0.0 : static_cast<double>(SDL_GetPerformanceFrequency()) / (options_.tick_rate_ * options_.time_scale_);
 }
 
-void Game::RenderQueuedTetrominoes()
+double Game::GetInterpolation() const
 {
-	SDL_RenderSetViewport(renderer_, &queue_viewport_);
-
-	for (const std::unique_ptr<Tetromino>& tetromino : queued_tetrominoes_)
+	if (IsUnlimitedSpeed())
 	{
-		tetromino->Render();
+		return 1.0;
 	}
-	
-	SDL_RenderSetViewport(renderer_, NULL);
+
+	const std::uint64_t now = SDL_GetPerformanceCounter();
+
+	return now > snapshot_->published_ ? std::min(1.0, static_cast<double>(now - snapshot_->published_) / GetTickPeriod()) : 0.0;
 }
 
-void Game::RenderBoards()
+std::uint64_t Game::RecordPhase(ProfilePhase phase, std::uint64_t start_counter)
 {
-	if (stashed_tetromino_ != nullptr)
+	const std::uint64_t end_counter = SDL_GetPerformanceCounter();
+	profiler_->Record(phase, start_counter, end_counter);
+	return end_counter;
+}
+
+void Game::RenderPerfOverlay()
+{
+	if (!perf_overlay_visible_)
 	{
-		RenderBoardCells(stash_board_, info_viewport_);
+		return;
 	}
 
-	RenderBoardCells(board_, board_viewport_);
-	RenderBoardCells(queue_board_, queue_viewport_);
+	constexpr Uint32 refresh_interval_ms = 250;
+	const Uint32 now = SDL_GetTicks();
 
-	if (stashed_tetromino_ != nullptr)
+	if (perf_lines_[0].empty() || now - perf_lines_updated_ >= refresh_interval_ms)
 	{
-		RenderBoardGridLines(stash_board_, stashed_tetromino_->GetBBoxDimension(), stashed_tetromino_->GetBBoxDimension(), info_viewport_);
-	}
+		for (std::size_t i = 0; i < perf_lines_.size(); ++i)
+		{
+			const ProfilePhase phase = static_cast<ProfilePhase>(i);
+			const PhaseStats stats = profiler_->GetStats(phase);
+			char line[96];
 
-	RenderBoardGridLines(board_, cells_width_, cells_height_, board_viewport_);
-	RenderBoardGridLines(queue_board_, 4, 12, queue_viewport_);
+			snprintf(line, sizeof(line), "%-12s p50 %6.3f  p99 %6.3f  max %7.3f ms", Profiler::GetPhaseName(phase), stats.p50_ms_, stats.p99_ms_, stats.max_ms_);
+			perf_lines_[i] = line;
+		}
 
-	SDL_SetRenderDrawColor(renderer_, 0xff, 0xff, 0xff, 0xff);
-	SDL_RenderSetViewport(renderer_, &info_viewport_);
+		perf_lines_updated_ = now;
+	}
+
+	const int line_height = perf_atlas_->GetHeight();
+	const SDL_Rect background = { 0, 0, info_viewport_.w + board_viewport_.w, line_height * static_cast<int>(perf_lines_.size()) + 8 };
 
-	stash_texture_->Render(renderer_, (info_viewport_.w / 2) - (stash_texture_->width_ / 2), stash_board_[0].rect_.y - (2 * cell_size_));
-	SDL_RenderDrawLine(renderer_, info_viewport_.w - 1, 0, info_viewport_.w - 1, info_viewport_.h);
-	
-	SDL_RenderSetViewport(renderer_, &queue_viewport_);
-	
-	next_texture_->Render(renderer_, (queue_viewport_.w / 2) - (next_texture_->width_ / 2), queue_board_[0].rect_.y - (2 * cell_size_));
-	SDL_RenderDrawLine(renderer_, 0, 0, 0, queue_viewport_.h);
-	
 	SDL_RenderSetViewport(renderer_, NULL);
+	SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND);
+	SDL_SetRenderDrawColor(renderer_, 0x00, 0x00, 0x00, 0xc0);
+	SDL_RenderFillRect(renderer_, &background);
+	SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_NONE);
+
+	for (std::size_t i = 0; i < perf_lines_.size(); ++i)
+	{
+		perf_atlas_->Render(renderer_, perf_lines_[i].c_str(), 4, 4 + static_cast<int>(i) * line_height);
+	}
 }
 
-void Game::RenderBoardGridLines(const std::vector<Cell>& board, std::size_t board_cells_width, std::size_t board_cells_height, const SDL_Rect& viewport)
+void Game::InitDrawList()
 {
-	SDL_SetRenderDrawColor(renderer_, 0x15, 0x16, 0x17, 0xff);
-	SDL_RenderSetViewport(renderer_, &viewport);
+	FrameGroups groups = {};
 
-	for (std::size_t i = 1; i < board_cells_width; ++i)
+	for (std::size_t i = 0; i < rotation_tables::types; ++i)
 	{
-		SDL_RenderDrawLine(renderer_, board[i].rect_.x, board.front().rect_.y, board[i].rect_.x, board.back().rect_.y + cell_size_);
+		groups.fills_[i] = draw_list_->AddGroup(tetromino_colors[i], DrawList::Mode::FILL);
 	}
 
-	for (std::size_t i = 1; i < board_cells_height; ++i)
+	for (std::size_t i = 0; i < rotation_tables::types; ++i)
 	{
-		SDL_RenderDrawLine(renderer_, board.front().rect_.x, board[i * board_cells_width].rect_.y, board.back().rect_.x + cell_size_, board[i * board_cells_width].rect_.y);
+		groups.outlines_[i] = draw_list_->AddGroup(tetromino_colors[i], DrawList::Mode::OUTLINE);
 	}
-	
-	SDL_RenderSetViewport(renderer_, NULL);
-}
 
-void Game::RenderBoardCells(const std::vector<Cell>& board, const SDL_Rect& viewport)
-{
-	SDL_RenderSetViewport(renderer_, &viewport);
+	groups.grid_ = draw_list_->AddGroup({ 0x15, 0x16, 0x17, 0xff }, DrawList::Mode::FILL);
 
-	std::for_each(board.begin(), board.end(), [](const Cell& cell)
-		{
-			cell.Render();
-		});
+	const FrameLayout layout = 
+	{
+		cell_size_, 
+		board_viewport_.x, 
+		board_viewport_.y, 
+		info_viewport_.x + stash_position_.x, 
+		info_viewport_.y + stash_position_.y, 
+		queue_viewport_.x + queue_position_.x, 
+		queue_viewport_.y + queue_position_.y
+	};
 
-	SDL_RenderSetViewport(renderer_, NULL);
+	frame_builder_ = std::make_unique<FrameBuilder>(layout, groups);
 }
 
-void Game::RenderInfo()
+bool Game::InitBoardLayers()
 {
-	SDL_RenderSetViewport(renderer_, &info_viewport_);
-
-	const int info_height = info_viewport_.h * 3 / 4;
-
-	score_texture_->Render(renderer_, (info_viewport_.w / 2) - (score_texture_->width_ / 2), info_height);
-	lines_texture_->Render(renderer_, (info_viewport_.w / 2) - (lines_texture_->width_ / 2), info_height + (lines_texture_->height_ * 2));
-
-	if (game_over_)
+	if (!SDL_RenderTargetSupported(renderer_))
 	{
-		game_over_texture_->Render(renderer_, (info_viewport_.w / 2) - (game_over_texture_->width_ / 2), (info_viewport_.h / 2) - (game_over_texture_->height_ / 2));
+		return false;
 	}
 
-	SDL_RenderSetViewport(renderer_, NULL);
+	return board_layer_->Create(renderer_, snapshot_->cells_width_ * cell_size_, snapshot_->cells_height_ * cell_size_) 
+		&& stash_layer_->Create(renderer_, 4 * cell_size_, 4 * cell_size_) 
+		&& queue_layer_->Create(renderer_, 4 * cell_size_, 12 * cell_size_);
 }
 
-void Game::GenerateTetrominoes()
+void Game::UpdateBoardLayers(int stash_dimension)
 {
-	std::vector<int> types_indices = { 0, 1, 2, 3, 4, 5, 6 };
-	std::random_device rd;
-    std::mt19937 mt(rd());
-    constexpr int permutations = 100;
-
-    for (int i = 0; i < permutations; ++i)
-    {
-	    std::shuffle(types_indices.begin(), types_indices.end(), mt);
-
-	    for (int index : types_indices)
-	    {
-	    	tetromino_queue_.emplace_back(static_cast<TetrominoType>(index));
-	    }
+	if (layered_board_version_ != snapshot_->board_version_)
+	{
+		board_layer_->MarkDirty();
 	}
-}
 
-void Game::SpawnTetromino(TetrominoType type, bool unstashing)
-{
-	if (falling_tetromino_ == nullptr)
+	if (layered_stash_dimension_ != stash_dimension)
 	{
-		falling_tetromino_ = std::make_unique<Tetromino>(this);
+		stash_layer_->MarkDirty();
 	}
 
-	std::vector<Cell*> bbox;
-	
-	const std::size_t bbox_side_size = (type == TetrominoType::I_BLOCK || type == TetrominoType::O_BLOCK) ? 4 : 3;
-
-	std::size_t cell_index = (cells_width_ / 2) - (bbox_side_size / 2) - 1;
-
-	for (std::size_t i = 0; i < bbox_side_size * bbox_side_size; ++i)
+	if (board_layer_->IsDirty())
 	{
-		bbox.push_back(&board_[cell_index]);
-
-		if ((i + 1) % bbox_side_size == 0)
-		{
-			cell_index += cells_width_ - (bbox_side_size - 1);
-		}
-		else
-		{
-			++cell_index;
-		}
+		board_layer_->BeginRedraw(renderer_);
+		frame_builder_->AddBoardCells(*draw_list_, *snapshot_, 0, 0);
+		frame_builder_->AddGridLines(*draw_list_, 0, 0, snapshot_->cells_width_, snapshot_->cells_height_);
+		draw_list_->Submit(renderer_);
+		board_layer_->EndRedraw(renderer_);
+		layered_board_version_ = snapshot_->board_version_;
 	}
 
-	falling_tetromino_->Initialize(bbox, type);
-
-	if (!unstashing)
+	if (stash_layer_->IsDirty())
 	{
-		tetromino_queue_.pop_front();
-
-		if (tetromino_queue_.size() < 10)
-		{
-			GenerateTetrominoes();
-		}
+		stash_layer_->BeginRedraw(renderer_);
+		frame_builder_->AddGridLines(*draw_list_, 0, 0, stash_dimension, stash_dimension);
+		draw_list_->Submit(renderer_);
+		stash_layer_->EndRedraw(renderer_);
+		layered_stash_dimension_ = stash_dimension;
 	}
 
-	for (std::size_t i = 0; i < bbox_side_size; ++i)
+	if (queue_layer_->IsDirty())
 	{
-		if (bbox[i]->occupied_)
-		{
-			game_over_ = true;
-		}
+		queue_layer_->BeginRedraw(renderer_);
+		frame_builder_->AddGridLines(*draw_list_, 0, 0, 4, 12);
+		draw_list_->Submit(renderer_);
+		queue_layer_->EndRedraw(renderer_);
 	}
 }
 
-void Game::SettleTetromino(int* score_)
-{
-	falling_tetromino_->SettleTetromino(score_);
-	ClearFilledLines();
-	DescendUnfilledLines();
-	SpawnTetromino(tetromino_queue_.front());
-	unstash_possible_ = stashed_tetromino_ != nullptr;
-	UpdateQueue();
-}
-
-void Game::UpdateScoreText()
+void Game::RenderBoards()
 {
-	SDL_Color text_color = { 0xff, 0xff, 0xff, 0xff };
-	const std::string score_text = "Score: " + std::to_string(score_);
-	score_texture_->LoadFromText(renderer_, font_, score_text.c_str(), text_color);
-}
+	const std::optional<TetrominoType>& stashed_type = snapshot_->stashed_type_;
 
-void Game::UpdateLinesText()
-{
-	SDL_Color text_color = { 0xff, 0xff, 0xff, 0xff };
-	const std::string lines_text = "Lines: " + std::to_string(lines_);
-	lines_texture_->LoadFromText(renderer_, font_, lines_text.c_str(), text_color);
-}
-
-void Game::ClearFilledLines()
-{
-	for (int i = 0; i < cells_height_; ++i)
+	if (layers_enabled_)
 	{
-		bool filled_line = true;
+		board_layer_->Render(renderer_, board_viewport_.x, board_viewport_.y);
 
-		for (int j = 0; j < cells_width_; ++j)
+		if (stashed_type.has_value())
 		{
-			if (!board_[i * cells_width_ + j].occupied_)
-			{
-				filled_line = false;
-				break;
-			}
+			stash_layer_->Render(renderer_, info_viewport_.x + stash_position_.x, info_viewport_.y + stash_position_.y);
 		}
 
-		if (filled_line)
-		{
-			for (int j = 0; j < cells_width_; ++j)
-			{
-				board_[i * cells_width_ + j].color_ = { 0x00, 0x00, 0x00, 0xff };
-				board_[i * cells_width_ + j].occupied_ = false;
-			}
-
-			score_ += 100;
-			++lines_;
-
-			if (lines_ % 10 == 0 && descend_speed_ > 10)
-			{
-				descend_speed_ -= 10;
-			}
-
-			UpdateLinesText();
-		}
+		queue_layer_->Render(renderer_, queue_viewport_.x + queue_position_.x, queue_viewport_.y + queue_position_.y);
+		return;
 	}
+
+	frame_builder_->AddBoards(*draw_list_, *snapshot_);
 }
 
-void Game::DescendUnfilledLines()
+void Game::RenderTetrominoes()
 {
-	for (int i = cells_height_ - 2; i >= 0; --i)
-	{
-		bool descend_line = false;
+	const double remaining = 1.0 - GetInterpolation();
 
-		for (int j = 0; j < cells_width_; ++j)
-		{
-			if (board_[i * cells_width_ + j].occupied_)
-			{
-				descend_line = true;
-				break;
-			}
-		}
+	interpolating_ = remaining > 0.0 && snapshot_->previous_piece_ != snapshot_->falling_piece_;
+	frame_builder_->AddPieces(*draw_list_, *snapshot_, remaining);
+}
 
-		if (!descend_line)
-		{
-			continue;
-		}
+void Game::RenderLabels()
+{
+	SDL_SetRenderDrawColor(renderer_, 0xff, 0xff, 0xff, 0xff);
+	SDL_RenderSetViewport(renderer_, &info_viewport_);
 
-		int fall_height = 0;
-		bool row_below_free = true;
+	stash_texture_->Render(renderer_, (info_viewport_.w / 2) - (stash_texture_->width_ / 2), stash_position_.y - (2 * cell_size_));
+	SDL_RenderDrawLine(renderer_, info_viewport_.w - 1, 0, info_viewport_.w - 1, info_viewport_.h);
+	
+	SDL_RenderSetViewport(renderer_, &queue_viewport_);
+	
+	next_texture_->Render(renderer_, (queue_viewport_.w / 2) - (next_texture_->width_ / 2), queue_position_.y - (2 * cell_size_));
+	SDL_RenderDrawLine(renderer_, 0, 0, 0, queue_viewport_.h);
+	
+	SDL_RenderSetViewport(renderer_, NULL);
+}
 
-		for (int k = 0; k < cells_height_ - 1 - i; ++k)
-		{
-			for (int j = 0; j < cells_width_; ++j)
-			{
-				if (board_[(i + (fall_height + 1)) * cells_width_ + j].occupied_)
-				{
-					row_below_free = false;
-					break;
-				}
-			}
+void Game::RenderInfo()
+{
+	SDL_RenderSetViewport(renderer_, &info_viewport_);
 
-			if (row_below_free)
-			{
-				++fall_height;
-			}
-		}
+	const int info_height = info_viewport_.h * 3 / 4;
 
+	hud_atlas_->Render(renderer_, score_text_.c_str(), (info_viewport_.w / 2) - (hud_atlas_->GetTextWidth(score_text_.c_str()) / 2), info_height);
+	hud_atlas_->Render(renderer_, lines_text_.c_str(), (info_viewport_.w / 2) - (hud_atlas_->GetTextWidth(lines_text_.c_str()) / 2), info_height + (hud_atlas_->GetHeight() * 2));
 
-		if (fall_height == 0)
-		{
-			continue;
-		}
+	if (snapshot_->game_over_)
+	{
+		game_over_texture_->Render(renderer_, (info_viewport_.w / 2) - (game_over_texture_->width_ / 2), (info_viewport_.h / 2) - (game_over_texture_->height_ / 2));
+	}
 
-		for (int j = 0; j < cells_width_; ++j)
-		{
-			board_[(i + fall_height) * cells_width_ + j].color_ = board_[i * cells_width_ + j].color_;
-			board_[(i + fall_height) * cells_width_ + j].occupied_ = board_[i * cells_width_ + j].occupied_;
+	SDL_RenderSetViewport(renderer_, NULL);
+}
 
-			board_[i * cells_width_ + j].color_ = { 0x00, 0x00, 0x00, 0xff };
-			board_[i * cells_width_ + j].occupied_ = false;
-		}
-	}
+void Game::UpdateScoreText()
+{
+	displayed_score_ = snapshot_->score_;
+	score_text_ = score_label + std::to_string(displayed_score_);
+	assert(hud_atlas_->GetHeight() == 0 || hud_atlas_->HasGlyphs(score_text_.c_str()));
 }
 
+void Game::UpdateLinesText()
+{
+	displayed_lines_ = snapshot_->lines_;
+	lines_text_ = lines_label + std::to_string(displayed_lines_);
+	assert(hud_atlas_->GetHeight() == 0 || hud_atlas_->HasGlyphs(lines_text_.c_str()));
+}
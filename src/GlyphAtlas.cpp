@@ -0,0 +1,209 @@
+#include "GlyphAtlas.hpp"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <algorithm>
+#include <cstddef>
+
+GlyphAtlas::GlyphAtlas() : texture_(nullptr), width_(0), height_(0), glyph_rects_(), loaded_()
+{
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+	FreeTexture();
+}
+
+void GlyphAtlas::FreeTexture()
+{
+	if (texture_ != nullptr)
+	{
+		SDL_DestroyTexture(texture_);
+		texture_ = nullptr;
+		width_ = 0;
+		height_ = 0;
+	}
+
+	loaded_.fill(false);
+}
+
+bool GlyphAtlas::LoadFromFont(SDL_Renderer* renderer, TTF_Font* font, const char* characters, const SDL_Color& color)
+{
+	FreeTexture();
+
+	std::array<SDL_Surface*, max_glyphs> glyph_surfaces = {};
+	int atlas_width = 0;
+	int atlas_height = 0;
+	bool success = true;
+
+	for (const char* c = characters; *c != '\0'; ++c)
+	{
+		const std::size_t index = static_cast<unsigned char>(*c);
+
+		if (index >= max_glyphs || glyph_surfaces[index] != nullptr)
+		{
+			continue;
+		}
+
+		glyph_surfaces[index] = TTF_RenderGlyph_Blended(font, static_cast<Uint16>(*c), color);
+
+		if (glyph_surfaces[index] == nullptr)
+		{
+			printf("Unable to render glyph '%c'! SDL_ttf Error: %s\n", *c, TTF_GetError());
+			success = false;
+			break;
+		}
+
+		atlas_width += glyph_surfaces[index]->w;
+		atlas_height = std::max(atlas_height, glyph_surfaces[index]->h);
+	}
+
+	SDL_Surface* atlas_surface = success ? SDL_CreateRGBSurfaceWithFormat(0, std::max(atlas_width, 1), std::max(atlas_height, 1), 32, SDL_PIXELFORMAT_RGBA32) : nullptr;
+
+	if (success && atlas_surface == nullptr)
+	{
+		printf("Unable to create glyph atlas surface! SDL Error: %s\n", SDL_GetError());
+		success = false;
+	}
+
+	int glyph_x = 0;
+
+	for (std::size_t i = 0; i < glyph_surfaces.size(); ++i)
+	{
+		if (glyph_surfaces[i] == nullptr)
+		{
+			continue;
+		}
+
+		if (success)
+		{
+			SDL_Rect glyph_rect = { glyph_x, 0, glyph_surfaces[i]->w, glyph_surfaces[i]->h };
+
+			SDL_SetSurfaceBlendMode(glyph_surfaces[i], SDL_BLENDMODE_NONE);
+			SDL_BlitSurface(glyph_surfaces[i], nullptr, atlas_surface, &glyph_rect);
+
+			glyph_rects_[i] = glyph_rect;
+			loaded_[i] = true;
+			glyph_x += glyph_rect.w;
+		}
+
+		SDL_FreeSurface(glyph_surfaces[i]);
+	}
+
+	if (!success)
+	{
+		loaded_.fill(false);
+
+		if (atlas_surface != nullptr)
+		{
+			SDL_FreeSurface(atlas_surface);
+		}
+
+		return false;
+	}
+
+	texture_ = SDL_CreateTextureFromSurface(renderer, atlas_surface);
+
+	if (texture_ == nullptr)
+	{
+		printf("Unable to create glyph atlas texture! SDL Error: %s\n", SDL_GetError());
+		SDL_FreeSurface(atlas_surface);
+		loaded_.fill(false);
+		return false;
+	}
+
+	SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
+	width_ = atlas_surface->w;
+	height_ = atlas_surface->h;
+	SDL_FreeSurface(atlas_surface);
+	return true;
+}
+
+bool GlyphAtlas::HasGlyphs(const char* text) const
+{
+	for (const char* c = text; *c != '\0'; ++c)
+	{
+		const std::size_t index = static_cast<unsigned char>(*c);
+
+		if (index >= max_glyphs || !loaded_[index])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int GlyphAtlas::GetTextWidth(const char* text) const
+{
+	int text_width = 0;
+
+	for (const char* c = text; *c != '\0'; ++c)
+	{
+		const std::size_t index = static_cast<unsigned char>(*c);
+
+		if (index < max_glyphs && loaded_[index])
+		{
+			text_width += glyph_rects_[index].w;
+		}
+	}
+
+	return text_width;
+}
+
+int GlyphAtlas::GetHeight() const
+{
+	return height_;
+}
+
+void GlyphAtlas::Render(SDL_Renderer* renderer, const char* text, int x, int y)
+{
+	if (texture_ == nullptr)
+	{
+		return;
+	}
+
+	vertices_.clear();
+	indices_.clear();
+
+	const float atlas_width = static_cast<float>(width_);
+	const float atlas_height = static_cast<float>(height_);
+	int glyph_x = x;
+
+	for (const char* c = text; *c != '\0'; ++c)
+	{
+		const std::size_t index = static_cast<unsigned char>(*c);
+
+		if (index >= max_glyphs || !loaded_[index])
+		{
+			continue;
+		}
+
+		const SDL_Rect& source = glyph_rects_[index];
+		const float left = static_cast<float>(glyph_x);
+		const float top = static_cast<float>(y);
+		const float right = left + source.w;
+		const float bottom = top + source.h;
+		const float u0 = source.x / atlas_width;
+		const float v0 = source.y / atlas_height;
+		const float u1 = (source.x + source.w) / atlas_width;
+		const float v1 = (source.y + source.h) / atlas_height;
+		const SDL_Color white = { 0xff, 0xff, 0xff, 0xff };
+		const int first_vertex = static_cast<int>(vertices_.size());
+
+		vertices_.push_back({ { left, top }, white, { u0, v0 } });
+		vertices_.push_back({ { right, top }, white, { u1, v0 } });
+		vertices_.push_back({ { right, bottom }, white, { u1, v1 } });
+		vertices_.push_back({ { left, bottom }, white, { u0, v1 } });
+
+		indices_.insert(indices_.end(), { first_vertex, first_vertex + 1, first_vertex + 2, first_vertex, first_vertex + 2, first_vertex + 3 });
+
+		glyph_x += source.w;
+	}
+
+	if (!vertices_.empty())
+	{
+		SDL_RenderGeometry(renderer, texture_, vertices_.data(), static_cast<int>(vertices_.size()), indices_.data(), static_cast<int>(indices_.size()));
+	}
+}
@@ -0,0 +1,108 @@
+#include "Profiler.hpp"
+#include "TableWriter.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+
+Profiler::Profiler(std::uint64_t counter_frequency) : 
+	histograms_(), 
+	counter_to_ms_(1000.0 / static_cast<double>(counter_frequency)), 
+	mutex_()
+{
+	for (Histogram& histogram : histograms_)
+	{
+		histogram.samples_ms_.reserve(window_size);
+		histogram.next_ = 0;
+		histogram.count_ = 0;
+	}
+}
+
+void Profiler::Record(ProfilePhase phase, std::uint64_t start_counter, std::uint64_t end_counter)
+{
+	assert(phase != ProfilePhase::COUNT);
+
+	const std::lock_guard<std::mutex> lock(mutex_);
+
+	Histogram& histogram = histograms_[static_cast<std::size_t>(phase)];
+	const double sample_ms = static_cast<double>(end_counter - start_counter) * counter_to_ms_;
+
+	if (histogram.samples_ms_.size() < window_size)
+	{
+		histogram.samples_ms_.push_back(sample_ms);
+	}
+	else
+	{
+		histogram.samples_ms_[histogram.next_] = sample_ms;
+	}
+
+	histogram.next_ = (histogram.next_ + 1) % window_size;
+	++histogram.count_;
+}
+
+PhaseStats Profiler::GetStats(ProfilePhase phase) const
+{
+	assert(phase != ProfilePhase::COUNT);
+
+	const std::lock_guard<std::mutex> lock(mutex_);
+
+	const Histogram& histogram = histograms_[static_cast<std::size_t>(phase)];
+	PhaseStats stats = { histogram.count_, 0.0, 0.0, 0.0 };
+
+	if (histogram.samples_ms_.empty())
+	{
+		return stats;
+	}
+
+	std::vector<double> sorted = histogram.samples_ms_;
+	std::sort(sorted.begin(), sorted.end());
+
+	stats.p50_ms_ = sorted[(sorted.size() - 1) * 50 / 100];
+	stats.p99_ms_ = sorted[(sorted.size() - 1) * 99 / 100];
+	stats.max_ms_ = sorted.back();
+	return stats;
+}
+
+const char* Profiler::GetPhaseName(ProfilePhase phase)
+{
+	switch (phase)
+	{
+		case ProfilePhase::HANDLE_EVENTS:
+			return "events";
+		case ProfilePhase::TICK:
+			return "tick";
+		case ProfilePhase::RENDER_BOARDS:
+			return "boards";
+		case ProfilePhase::RENDER_TETROMINOES:
+			return "tetrominoes";
+		case ProfilePhase::RENDER_INFO:
+			return "info";
+		case ProfilePhase::RENDER_PRESENT:
+			return "present";
+		case ProfilePhase::FRAME:
+			return "frame";
+		default:
+			return "unknown";
+	}
+}
+
+bool Profiler::Dump(const std::string& path) const
+{
+	TableWriter table(path, { "phase", "count", "p50_ms", "p99_ms", "max_ms" });
+
+	if (!table.IsOpen())
+	{
+		printf("Unable to open profile dump '%s' for writing!\n", path.c_str());
+		return false;
+	}
+
+	for (std::size_t i = 0; i < histograms_.size(); ++i)
+	{
+		const ProfilePhase phase = static_cast<ProfilePhase>(i);
+		const PhaseStats stats = GetStats(phase);
+
+		table.AddRow(GetPhaseName(phase), stats.count_, stats.p50_ms_, stats.p99_ms_, stats.max_ms_);
+	}
+
+	return table.Finish();
+}
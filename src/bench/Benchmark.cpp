@@ -0,0 +1,91 @@
+#include "Benchmark.hpp"
+#include "TableWriter.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+Benchmark::Benchmark(int samples) : 
+	samples_(samples > 0 ? samples : 1), 
+	results_()
+{
+}
+
+const BenchmarkResult& Benchmark::Run(const std::string& name, const Setup& setup, const Batch& batch)
+{
+	std::vector<double> sample_ns;
+	sample_ns.reserve(samples_);
+
+	BenchmarkResult result = { name, samples_, 0, 0.0, 0.0, 0.0 };
+	double total_ns = 0.0;
+
+	for (int i = 0; i < samples_; ++i)
+	{
+		if (setup)
+		{
+			setup();
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		const std::uint64_t operations = batch();
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (operations == 0)
+		{
+			continue;
+		}
+
+		sample_ns.push_back(elapsed.count() / operations);
+		result.operations_ += operations;
+		total_ns += elapsed.count();
+	}
+
+	if (!sample_ns.empty())
+	{
+		std::sort(sample_ns.begin(), sample_ns.end());
+		result.min_ns_ = sample_ns.front();
+		result.p50_ns_ = sample_ns[sample_ns.size() / 2];
+		result.mean_ns_ = total_ns / result.operations_;
+	}
+
+	results_.push_back(result);
+	return results_.back();
+}
+
+const std::vector<BenchmarkResult>& Benchmark::GetResults() const
+{
+	return results_;
+}
+
+void Benchmark::Print() const
+{
+	printf("name,samples,operations,min_ns,p50_ns,mean_ns\n");
+
+	for (const BenchmarkResult& result : results_)
+	{
+		printf("%s,%d,%llu,%.2f,%.2f,%.2f\n", 
+			result.name_.c_str(), 
+			result.samples_, 
+			static_cast<unsigned long long>(result.operations_), 
+			result.min_ns_, 
+			result.p50_ns_, 
+			result.mean_ns_);
+	}
+}
+
+bool Benchmark::Dump(const std::string& path) const
+{
+	TableWriter table(path, { "name", "samples", "operations", "min_ns", "p50_ns", "mean_ns" });
+
+	if (!table.IsOpen())
+	{
+		printf("Unable to open benchmark output '%s' for writing!\n", path.c_str());
+		return false;
+	}
+
+	for (const BenchmarkResult& result : results_)
+	{
+		table.AddRow(result.name_, result.samples_, result.operations_, result.min_ns_, result.p50_ns_, result.mean_ns_);
+	}
+
+	return table.Finish();
+}
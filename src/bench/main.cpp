@@ -0,0 +1,452 @@
+#include "Benchmark.hpp"
+#include "BoardFeatures.hpp"
+#include "Bot.hpp"
+#include "Constants.hpp"
+#include "Engine.hpp"
+#include "FrameBuilder.hpp"
+#include "PieceSource.hpp"
+#include "PieceState.hpp"
+#include "RenderSnapshot.hpp"
+#include "RotationTables.hpp"
+#include "VectorEnvironment.hpp"
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr int width = constants::board_cells_width;
+	constexpr int height = constants::board_cells_height;
+	constexpr std::uint32_t seed = 12345;
+
+	struct FrameRect
+	{
+		int x_;
+		int y_;
+		int w_;
+		int h_;
+	};
+
+	// Stands in for DrawList, which needs SDL to submit; FrameBuilder fills it exactly the same way.
+	class FrameRects
+	{
+	public:
+		static constexpr std::size_t groups = rotation_tables::types * 2 + 1;
+
+	private:
+		std::array<std::vector<FrameRect>, groups> rects_;
+
+	public:
+		void AddRect(std::size_t group, const FrameRect& rect)
+		{
+			rects_[group].push_back(rect);
+		}
+
+		void Clear()
+		{
+			for (std::vector<FrameRect>& rects : rects_)
+			{
+				rects.clear();
+			}
+		}
+	};
+
+	void FillStack(Engine& engine, int stack_height, int full_rows)
+	{
+		engine.Reset();
+
+		for (int y = height - stack_height; y < height; ++y)
+		{
+			const int hole = y >= height - full_rows ? -1 : y % width;
+
+			for (int x = 0; x < width; ++x)
+			{
+				if (x == hole)
+				{
+					continue;
+				}
+
+				engine.cell_types_[y * width + x] = static_cast<TetrominoType>((x + y) % rotation_tables::types);
+				engine.bitboard_.SetOccupied(x, y, true);
+			}
+		}
+	}
+
+	void BenchmarkLineClear(Benchmark& benchmark, int stack_height, int full_rows)
+	{
+		constexpr int engines_count = 64;
+
+		std::vector<std::unique_ptr<Engine>> engines;
+
+		for (int i = 0; i < engines_count; ++i)
+		{
+			engines.push_back(std::make_unique<Engine>(width, height, seed));
+		}
+
+		const std::string name = "line_clear_h" + std::to_string(stack_height) + "_x" + std::to_string(full_rows);
+
+		benchmark.Run(name, [&]()
+		{
+			for (std::unique_ptr<Engine>& engine : engines)
+			{
+				FillStack(*engine, stack_height, full_rows);
+			}
+		}, [&]()
+		{
+			for (std::unique_ptr<Engine>& engine : engines)
+			{
+				engine->ClearFilledLines();
+			}
+
+			return static_cast<std::uint64_t>(engines.size());
+		});
+	}
+
+	void BenchmarkRotation(Benchmark& benchmark)
+	{
+		Bitboard bitboard;
+		bitboard.Resize(width, height);
+
+		PieceState piece = {};
+		int type = 0;
+
+		benchmark.Run("rotate", [&]()
+		{
+			piece = PieceState::Spawn(static_cast<TetrominoType>(type++ % rotation_tables::types), 3, height / 2);
+		}, [&]()
+		{
+			constexpr int rotations = 4096;
+
+			for (int i = 0; i < rotations; ++i)
+			{
+				if (const std::optional<PieceState> rotated = piece.Rotated(bitboard, i % 8 < 4 ? 90 : 270))
+				{
+					piece = *rotated;
+				}
+			}
+
+			return static_cast<std::uint64_t>(rotations);
+		});
+	}
+
+	void BenchmarkMove(Benchmark& benchmark)
+	{
+		Bitboard bitboard;
+		bitboard.Resize(width, height);
+
+		PieceState piece = {};
+		int type = 0;
+
+		benchmark.Run("move", [&]()
+		{
+			piece = PieceState::Spawn(static_cast<TetrominoType>(type++ % rotation_tables::types), 3, height / 2);
+		}, [&]()
+		{
+			constexpr int moves = 4096;
+
+			for (int i = 0; i < moves; ++i)
+			{
+				if (const std::optional<PieceState> moved = piece.Moved(bitboard, i % 16 < 8 ? 1 : -1))
+				{
+					piece = *moved;
+				}
+			}
+
+			return static_cast<std::uint64_t>(moves);
+		});
+	}
+
+	void BenchmarkDescend(Benchmark& benchmark)
+	{
+		Engine engine(width, height, seed);
+		FillStack(engine, height / 4, 0);
+
+		PieceState piece = {};
+		int type = 0;
+
+		benchmark.Run("descend", [&]()
+		{
+			piece = PieceState::Spawn(static_cast<TetrominoType>(type++ % rotation_tables::types), 3, 0);
+		}, [&]()
+		{
+			std::uint64_t descents = 0;
+
+			while (const std::optional<PieceState> descended = piece.Descended(engine.bitboard_))
+			{
+				piece = *descended;
+				++descents;
+			}
+
+			return descents;
+		});
+	}
+
+	void BenchmarkHardDrop(Benchmark& benchmark)
+	{
+		Engine engine(width, height, seed);
+
+		benchmark.Run("hard_drop", [&]()
+		{
+			engine.Reset();
+		}, [&]()
+		{
+			std::uint64_t drops = 0;
+
+			while (!engine.IsGameOver())
+			{
+				engine.SettleTetromino();
+				++drops;
+			}
+
+			return drops;
+		});
+	}
+
+	void BenchmarkSpawn(Benchmark& benchmark)
+	{
+		Engine engine(width, height, seed);
+
+		benchmark.Run("spawn", [&]()
+		{
+			engine.Reset();
+		}, [&]()
+		{
+			constexpr int spawns = 4096;
+
+			for (int i = 0; i < spawns; ++i)
+			{
+				engine.SpawnTetromino(engine.GetQueuedType(0));
+			}
+
+			return static_cast<std::uint64_t>(spawns);
+		});
+	}
+
+	void BenchmarkBagGeneration(Benchmark& benchmark, PieceSourceMode mode)
+	{
+		PieceSource piece_source(mode, seed);
+
+		benchmark.Run(std::string("next_piece_") + PieceSource::GetModeName(mode), nullptr, [&]()
+		{
+			constexpr int pieces = 4096;
+
+			for (int i = 0; i < pieces; ++i)
+			{
+				piece_source.Next();
+			}
+
+			return static_cast<std::uint64_t>(pieces);
+		});
+	}
+
+	void BenchmarkBoardFeatures(Benchmark& benchmark, FeatureKernel kernel)
+	{
+		Engine engine(width, height, seed);
+		FillStack(engine, height / 2, 0);
+
+		std::vector<Bitboard> boards;
+
+		for (std::size_t type = 0; type < rotation_tables::types; ++type)
+		{
+			for (int x = -2; x < width; ++x)
+			{
+				PieceState piece = PieceState::Spawn(static_cast<TetrominoType>(type), x, 0);
+
+				if (!piece.Collides(engine.bitboard_))
+				{
+					boards.push_back(engine.bitboard_);
+					piece.Dropped(engine.bitboard_).Place(&boards.back());
+				}
+			}
+		}
+
+		BoardBatch batch;
+		batch.Reset(width, height, boards.size());
+
+		for (const Bitboard& board : boards)
+		{
+			batch.Add(board);
+		}
+
+		std::vector<BoardFeatures> features(boards.size());
+
+		benchmark.Run(std::string("board_features_") + GetFeatureKernelName(kernel), nullptr, [&]()
+		{
+			constexpr int batches = 64;
+
+			for (int i = 0; i < batches; ++i)
+			{
+				ExtractBoardFeatures(batch, features.data(), kernel);
+			}
+
+			return static_cast<std::uint64_t>(batches * boards.size());
+		});
+	}
+
+	void BenchmarkBotThink(Benchmark& benchmark, int lookahead)
+	{
+		Engine engine(width, height, seed);
+		FillStack(engine, height / 2, 0);
+
+		BotOptions options = Bot::GetDefaultOptions();
+		options.lookahead_ = lookahead;
+
+		Bot bot(options);
+		BotPlan plan;
+
+		benchmark.Run("bot_think_lookahead_" + std::to_string(lookahead), nullptr, [&]()
+		{
+			const std::uint64_t evaluated = bot.GetEvaluatedPlacements();
+			constexpr int thinks = 16;
+
+			for (int i = 0; i < thinks; ++i)
+			{
+				bot.Think(engine, &plan);
+			}
+
+			return bot.GetEvaluatedPlacements() - evaluated;
+		});
+	}
+
+	void BenchmarkVectorEnvironment(Benchmark& benchmark)
+	{
+		constexpr std::size_t environments = 256;
+
+		VectorEnvironment environment({ environments, seed, 1, 1, PieceSourceMode::SEVEN_BAG });
+
+		std::vector<std::uint8_t> actions(environments);
+		std::vector<std::uint8_t> observations(environments * environment.GetObservationSize());
+		std::vector<float> rewards(environments);
+		std::vector<std::uint8_t> dones(environments);
+		std::uint32_t step = 0;
+
+		environment.Reset(observations.data());
+
+		benchmark.Run("vector_environment_step", nullptr, [&]()
+		{
+			constexpr int steps = 64;
+
+			for (int i = 0; i < steps; ++i, ++step)
+			{
+				for (std::size_t j = 0; j < environments; ++j)
+				{
+					actions[j] = static_cast<std::uint8_t>((step * 7 + j) % VectorEnvironment::action_count);
+				}
+
+				environment.Step(actions.data(), observations.data(), rewards.data(), dones.data());
+			}
+
+			return static_cast<std::uint64_t>(steps * environments);
+		});
+	}
+
+	void BenchmarkRenderFrame(Benchmark& benchmark)
+	{
+		Engine engine(width, height, seed);
+		FillStack(engine, height / 2, 0);
+		engine.TriggerStashTetromino();
+
+		std::unique_ptr<RenderSnapshot> snapshot = std::make_unique<RenderSnapshot>();
+		PieceState previous = engine.GetFallingPiece();
+		--previous.y_;
+		snapshot->Capture(engine, 0, 0, previous);
+
+		FrameGroups groups = {};
+
+		for (std::size_t i = 0; i < rotation_tables::types; ++i)
+		{
+			groups.fills_[i] = i;
+			groups.outlines_[i] = rotation_tables::types + i;
+		}
+
+		groups.grid_ = FrameRects::groups - 1;
+
+		// Same window layout as Game, drawn without board layers so every frame walks the whole board.
+		constexpr int cell_size = constants::cell_size;
+		constexpr int viewport_width = constants::screen_width / 3;
+		const FrameLayout layout = { cell_size, viewport_width, 0, 96, 160, viewport_width * 2 + 96, 160 };
+		const FrameBuilder builder(layout, groups);
+		FrameRects frame;
+
+		benchmark.Run("render_frame_headless", nullptr, [&]()
+		{
+			constexpr int frames = 256;
+
+			for (int i = 0; i < frames; ++i)
+			{
+				frame.Clear();
+				builder.AddBoards(frame, *snapshot);
+				builder.AddPieces(frame, *snapshot, 0.5);
+			}
+
+			return static_cast<std::uint64_t>(frames);
+		});
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	int samples = 101;
+	std::string output_path;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc)
+		{
+			samples = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+		{
+			output_path = argv[++i];
+		}
+		else
+		{
+			printf("Usage: %s [--samples N] [--output PATH]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Benchmark benchmark(samples);
+
+	BenchmarkLineClear(benchmark, 4, 4);
+	BenchmarkLineClear(benchmark, 10, 1);
+	BenchmarkLineClear(benchmark, 10, 4);
+	BenchmarkLineClear(benchmark, height - 1, 1);
+	BenchmarkLineClear(benchmark, height - 1, 4);
+	BenchmarkRotation(benchmark);
+	BenchmarkMove(benchmark);
+	BenchmarkDescend(benchmark);
+	BenchmarkHardDrop(benchmark);
+	BenchmarkSpawn(benchmark);
+	BenchmarkBagGeneration(benchmark, PieceSourceMode::SEVEN_BAG);
+	BenchmarkBagGeneration(benchmark, PieceSourceMode::FOURTEEN_BAG);
+	BenchmarkBagGeneration(benchmark, PieceSourceMode::CLASSIC);
+
+	for (std::size_t i = 0; i < static_cast<std::size_t>(FeatureKernel::COUNT); ++i)
+	{
+		if (IsFeatureKernelSupported(static_cast<FeatureKernel>(i)))
+		{
+			BenchmarkBoardFeatures(benchmark, static_cast<FeatureKernel>(i));
+		}
+	}
+
+	BenchmarkBotThink(benchmark, 0);
+	BenchmarkBotThink(benchmark, 1);
+	BenchmarkVectorEnvironment(benchmark);
+	BenchmarkRenderFrame(benchmark);
+
+	benchmark.Print();
+
+	if (!output_path.empty() && !benchmark.Dump(output_path))
+	{
+		return 1;
+	}
+
+	return 0;
+}
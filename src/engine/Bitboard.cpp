@@ -0,0 +1,228 @@
+#include "Bitboard.hpp"
+#include "Zobrist.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace
+{
+	constexpr std::array<std::uint64_t, Bitboard::max_width * Bitboard::max_height> cell_keys = zobrist::MakeKeys<Bitboard::max_width * Bitboard::max_height>(0);
+}
+
+Bitboard::Bitboard() : width_(0), height_(0), full_row_(0), rows_(), hash_(0), column_tops_(), column_tops_dirty_(true)
+{
+}
+
+void Bitboard::Resize(int width, int height)
+{
+	assert(width > 0 && width <= max_width && height > 0 && height <= max_height);
+
+	width_ = width;
+	height_ = height;
+	full_row_ = static_cast<Row>((1u << width) - 1);
+	rows_.fill(0);
+	hash_ = 0;
+	column_tops_dirty_ = true;
+}
+
+void Bitboard::Clear()
+{
+	rows_.fill(0);
+	hash_ = 0;
+	column_tops_dirty_ = true;
+}
+
+int Bitboard::GetWidth() const
+{
+	return width_;
+}
+
+int Bitboard::GetHeight() const
+{
+	return height_;
+}
+
+Bitboard::Row Bitboard::GetRow(int y) const
+{
+	assert(y >= 0 && y < height_);
+	return rows_[y];
+}
+
+const Bitboard::Row* Bitboard::GetRows() const
+{
+	return rows_.data();
+}
+
+void Bitboard::SetRow(int y, Row row)
+{
+	assert(y >= 0 && y < height_);
+	row &= full_row_;
+	hash_ ^= GetRowHash(y, rows_[y] ^ row);
+	rows_[y] = row;
+	column_tops_dirty_ = true;
+}
+
+Bitboard::Row Bitboard::GetFullRow() const
+{
+	return full_row_;
+}
+
+bool Bitboard::IsRowFull(int y) const
+{
+	return GetRow(y) == full_row_;
+}
+
+bool Bitboard::IsRowEmpty(int y) const
+{
+	return GetRow(y) == 0;
+}
+
+bool Bitboard::IsOccupied(int x, int y) const
+{
+	assert(x >= 0 && x < width_);
+	return (GetRow(y) >> x) & 1u;
+}
+
+void Bitboard::SetOccupied(int x, int y, bool occupied)
+{
+	assert(x >= 0 && x < width_ && y >= 0 && y < height_);
+
+	if (IsOccupied(x, y) != occupied)
+	{
+		rows_[y] ^= static_cast<Row>(1u << x);
+		hash_ ^= cell_keys[y * max_width + x];
+	}
+
+	column_tops_dirty_ = true;
+}
+
+int Bitboard::GetColumnTop(int x) const
+{
+	assert(x >= 0 && x < width_);
+
+	if (column_tops_dirty_)
+	{
+		UpdateColumnTops();
+	}
+
+	return column_tops_[x];
+}
+
+void Bitboard::UpdateColumnTops() const
+{
+	column_tops_.fill(height_);
+
+	Row seen = 0;
+
+	for (int y = 0; y < height_ && seen != full_row_; ++y)
+	{
+		Row first_seen = rows_[y] & static_cast<Row>(~seen);
+		seen |= rows_[y];
+
+		for (int x = 0; first_seen != 0; ++x, first_seen >>= 1)
+		{
+			if (first_seen & 1u)
+			{
+				column_tops_[x] = y;
+			}
+		}
+	}
+
+	column_tops_dirty_ = false;
+}
+
+bool Bitboard::Collides(const PieceRows& rows, int x, int y) const
+{
+	assert(x > -max_width && x < max_width);
+
+	for (std::size_t i = 0; i < rows.size(); ++i)
+	{
+		if (rows[i] == 0)
+		{
+			continue;
+		}
+
+		const int row_y = y + static_cast<int>(i);
+
+		if (row_y < 0 || row_y >= height_)
+		{
+			return true;
+		}
+
+		std::uint32_t shifted = rows[i];
+
+		if (x >= 0)
+		{
+			shifted <<= x;
+		}
+		else
+		{
+			if ((shifted & ((1u << -x) - 1)) != 0)
+			{
+				return true;
+			}
+
+			shifted >>= -x;
+		}
+
+		if ((shifted & ~static_cast<std::uint32_t>(full_row_)) != 0)
+		{
+			return true;
+		}
+
+		if ((shifted & rows_[row_y]) != 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int Bitboard::ClearFullRows()
+{
+	int write_row = height_ - 1;
+	int read_row = height_ - 1;
+
+	for (; read_row >= 0 && rows_[read_row] != 0; --read_row)
+	{
+		if (rows_[read_row] != full_row_)
+		{
+			hash_ ^= GetRowHash(write_row, rows_[write_row] ^ rows_[read_row]);
+			rows_[write_row--] = rows_[read_row];
+		}
+	}
+
+	const int cleared = write_row - read_row;
+
+	for (; write_row > read_row; --write_row)
+	{
+		hash_ ^= GetRowHash(write_row, rows_[write_row]);
+		rows_[write_row] = 0;
+	}
+
+	if (cleared > 0)
+	{
+		column_tops_dirty_ = true;
+	}
+
+	return cleared;
+}
+
+std::uint64_t Bitboard::GetHash() const
+{
+	return hash_;
+}
+
+std::uint64_t Bitboard::GetRowHash(int y, Row bits)
+{
+	std::uint64_t hash = 0;
+
+	for (; bits != 0; bits &= static_cast<Row>(bits - 1))
+	{
+		hash ^= cell_keys[y * max_width + __builtin_ctz(bits)];
+	}
+
+	return hash;
+}
@@ -0,0 +1,385 @@
+#include "BoardFeatures.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BOARD_FEATURES_X86 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	// Every feature is accumulated row by row from the row bitmask and the running union of the
+	// rows above it (covered), so the same steps work on one board or on a vector of boards: 
+	// a column is counted in a row's height once it is covered, bumpiness counts rows where two
+	// neighbouring columns disagree, and well depths are kept as bit-sliced per-column counters.
+	constexpr int max_well_planes = 7;
+
+	int GetWellPlanes(int height)
+	{
+		int planes = 1;
+
+		while ((1 << planes) <= height)
+		{
+			++planes;
+		}
+
+		assert(planes <= max_well_planes);
+		return planes;
+	}
+
+	BoardFeatures ExtractScalar(const Bitboard::Row* rows, std::size_t stride, int width, int height)
+	{
+		const std::uint32_t full = (1u << width) - 1;
+		const std::uint32_t inner = full >> 1;
+		const std::uint32_t edges = 1u | (1u << (width - 1));
+		const std::uint32_t right_wall = 1u << (width - 1);
+		const int planes = GetWellPlanes(height);
+
+		BoardFeatures features = { 0, 0, 0, 0, 0, 0 };
+		std::array<std::uint32_t, max_well_planes> runs = {};
+		std::uint32_t covered = 0;
+
+		for (int y = 0; y < height; ++y)
+		{
+			const std::uint32_t row = rows[y * stride];
+
+			features.holes_ += __builtin_popcount(covered & ~row);
+			covered |= row;
+
+			if (covered == 0)
+			{
+				continue;
+			}
+
+			features.aggregate_height_ += __builtin_popcount(covered);
+			features.bumpiness_ += __builtin_popcount((covered ^ (covered >> 1)) & inner);
+			features.row_transitions_ += __builtin_popcount((row ^ (row >> 1)) & inner) + __builtin_popcount(~row & edges);
+			++features.max_height_;
+
+			const std::uint32_t well = ~covered & ((row << 1) | 1u) & ((row >> 1) | right_wall) & full;
+			std::uint32_t carry = well;
+
+			for (int p = 0; p < planes; ++p)
+			{
+				const std::uint32_t run = runs[p];
+				runs[p] = (run ^ carry) & well;
+				carry &= run;
+				features.wells_ += __builtin_popcount(runs[p]) << p;
+			}
+		}
+
+		return features;
+	}
+
+	void ExtractBatchScalar(const BoardBatch& batch, BoardFeatures* features)
+	{
+		for (std::size_t i = 0; i < batch.GetSize(); ++i)
+		{
+			features[i] = ExtractScalar(batch.GetRows() + i, batch.GetStride(), batch.GetWidth(), batch.GetHeight());
+		}
+	}
+
+	void StoreLanes(const std::uint16_t (*sums)[BoardBatch::lanes], std::size_t first, std::size_t count, BoardFeatures* features)
+	{
+		for (std::size_t lane = 0; lane < count; ++lane)
+		{
+			features[first + lane] = { sums[0][lane], sums[1][lane], sums[2][lane], sums[3][lane], sums[4][lane], sums[5][lane] };
+		}
+	}
+
+#ifdef BOARD_FEATURES_X86
+	__attribute__((target("ssse3"))) __m128i PopCount16(__m128i value)
+	{
+		const __m128i lookup = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m128i nibble = _mm_set1_epi8(0x0f);
+		const __m128i low = _mm_shuffle_epi8(lookup, _mm_and_si128(value, nibble));
+		const __m128i high = _mm_shuffle_epi8(lookup, _mm_and_si128(_mm_srli_epi16(value, 4), nibble));
+		const __m128i bytes = _mm_add_epi8(low, high);
+
+		return _mm_add_epi16(_mm_and_si128(bytes, _mm_set1_epi16(0x00ff)), _mm_srli_epi16(bytes, 8));
+	}
+
+	__attribute__((target("ssse3"))) void ExtractBatchSsse3(const BoardBatch& batch, BoardFeatures* features)
+	{
+		constexpr std::size_t width = 8;
+
+		const int board_width = batch.GetWidth();
+		const int height = batch.GetHeight();
+		const int planes = GetWellPlanes(height);
+		const std::size_t stride = batch.GetStride();
+		const Bitboard::Row* rows = batch.GetRows();
+
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i one = _mm_set1_epi16(1);
+		const __m128i full = _mm_set1_epi16(static_cast<short>((1u << board_width) - 1));
+		const __m128i inner = _mm_srli_epi16(full, 1);
+		const __m128i right_wall = _mm_set1_epi16(static_cast<short>(1u << (board_width - 1)));
+		const __m128i edges = _mm_or_si128(one, right_wall);
+
+		alignas(16) std::uint16_t sums[6][BoardBatch::lanes];
+
+		for (std::size_t first = 0; first < batch.GetSize(); first += width)
+		{
+			__m128i covered = zero;
+			__m128i height_sum = zero;
+			__m128i holes = zero;
+			__m128i bumpiness = zero;
+			__m128i max_height = zero;
+			__m128i transitions = zero;
+			__m128i wells = zero;
+			__m128i runs[max_well_planes] = {};
+
+			for (int y = 0; y < height; ++y)
+			{
+				const __m128i row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows + y * stride + first));
+
+				holes = _mm_add_epi16(holes, PopCount16(_mm_andnot_si128(row, covered)));
+				covered = _mm_or_si128(covered, row);
+
+				const __m128i empty = _mm_cmpeq_epi16(covered, zero);
+				const __m128i row_transitions = _mm_add_epi16(PopCount16(_mm_and_si128(_mm_xor_si128(row, _mm_srli_epi16(row, 1)), inner)), PopCount16(_mm_andnot_si128(row, edges)));
+
+				height_sum = _mm_add_epi16(height_sum, PopCount16(covered));
+				bumpiness = _mm_add_epi16(bumpiness, PopCount16(_mm_and_si128(_mm_xor_si128(covered, _mm_srli_epi16(covered, 1)), inner)));
+				transitions = _mm_add_epi16(transitions, _mm_andnot_si128(empty, row_transitions));
+				max_height = _mm_add_epi16(max_height, _mm_andnot_si128(empty, one));
+
+				const __m128i neighbours = _mm_and_si128(_mm_or_si128(_mm_slli_epi16(row, 1), one), _mm_or_si128(_mm_srli_epi16(row, 1), right_wall));
+				const __m128i well = _mm_and_si128(_mm_andnot_si128(covered, neighbours), full);
+				__m128i carry = well;
+
+				for (int p = 0; p < planes; ++p)
+				{
+					const __m128i run = runs[p];
+					runs[p] = _mm_and_si128(_mm_xor_si128(run, carry), well);
+					carry = _mm_and_si128(carry, run);
+					wells = _mm_add_epi16(wells, _mm_sll_epi16(PopCount16(runs[p]), _mm_cvtsi32_si128(p)));
+				}
+			}
+
+			_mm_store_si128(reinterpret_cast<__m128i*>(sums[0]), height_sum);
+			_mm_store_si128(reinterpret_cast<__m128i*>(sums[1]), holes);
+			_mm_store_si128(reinterpret_cast<__m128i*>(sums[2]), bumpiness);
+			_mm_store_si128(reinterpret_cast<__m128i*>(sums[3]), max_height);
+			_mm_store_si128(reinterpret_cast<__m128i*>(sums[4]), transitions);
+			_mm_store_si128(reinterpret_cast<__m128i*>(sums[5]), wells);
+
+			StoreLanes(sums, first, std::min(width, batch.GetSize() - first), features);
+		}
+	}
+
+	__attribute__((target("avx2"))) __m256i PopCount16(__m256i value)
+	{
+		const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i nibble = _mm256_set1_epi8(0x0f);
+		const __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(value, nibble));
+		const __m256i high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(value, 4), nibble));
+		const __m256i bytes = _mm256_add_epi8(low, high);
+
+		return _mm256_add_epi16(_mm256_and_si256(bytes, _mm256_set1_epi16(0x00ff)), _mm256_srli_epi16(bytes, 8));
+	}
+
+	__attribute__((target("avx2"))) void ExtractBatchAvx2(const BoardBatch& batch, BoardFeatures* features)
+	{
+		constexpr std::size_t width = 16;
+
+		const int board_width = batch.GetWidth();
+		const int height = batch.GetHeight();
+		const int planes = GetWellPlanes(height);
+		const std::size_t stride = batch.GetStride();
+		const Bitboard::Row* rows = batch.GetRows();
+
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i one = _mm256_set1_epi16(1);
+		const __m256i full = _mm256_set1_epi16(static_cast<short>((1u << board_width) - 1));
+		const __m256i inner = _mm256_srli_epi16(full, 1);
+		const __m256i right_wall = _mm256_set1_epi16(static_cast<short>(1u << (board_width - 1)));
+		const __m256i edges = _mm256_or_si256(one, right_wall);
+
+		alignas(32) std::uint16_t sums[6][BoardBatch::lanes];
+
+		for (std::size_t first = 0; first < batch.GetSize(); first += width)
+		{
+			__m256i covered = zero;
+			__m256i height_sum = zero;
+			__m256i holes = zero;
+			__m256i bumpiness = zero;
+			__m256i max_height = zero;
+			__m256i transitions = zero;
+			__m256i wells = zero;
+			__m256i runs[max_well_planes] = {};
+
+			for (int y = 0; y < height; ++y)
+			{
+				const __m256i row = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows + y * stride + first));
+
+				holes = _mm256_add_epi16(holes, PopCount16(_mm256_andnot_si256(row, covered)));
+				covered = _mm256_or_si256(covered, row);
+
+				const __m256i empty = _mm256_cmpeq_epi16(covered, zero);
+				const __m256i row_transitions = _mm256_add_epi16(PopCount16(_mm256_and_si256(_mm256_xor_si256(row, _mm256_srli_epi16(row, 1)), inner)), PopCount16(_mm256_andnot_si256(row, edges)));
+
+				height_sum = _mm256_add_epi16(height_sum, PopCount16(covered));
+				bumpiness = _mm256_add_epi16(bumpiness, PopCount16(_mm256_and_si256(_mm256_xor_si256(covered, _mm256_srli_epi16(covered, 1)), inner)));
+				transitions = _mm256_add_epi16(transitions, _mm256_andnot_si256(empty, row_transitions));
+				max_height = _mm256_add_epi16(max_height, _mm256_andnot_si256(empty, one));
+
+				const __m256i neighbours = _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi16(row, 1), one), _mm256_or_si256(_mm256_srli_epi16(row, 1), right_wall));
+				const __m256i well = _mm256_and_si256(_mm256_andnot_si256(covered, neighbours), full);
+				__m256i carry = well;
+
+				for (int p = 0; p < planes; ++p)
+				{
+					const __m256i run = runs[p];
+					runs[p] = _mm256_and_si256(_mm256_xor_si256(run, carry), well);
+					carry = _mm256_and_si256(carry, run);
+					wells = _mm256_add_epi16(wells, _mm256_sll_epi16(PopCount16(runs[p]), _mm_cvtsi32_si128(p)));
+				}
+			}
+
+			_mm256_store_si256(reinterpret_cast<__m256i*>(sums[0]), height_sum);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(sums[1]), holes);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(sums[2]), bumpiness);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(sums[3]), max_height);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(sums[4]), transitions);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(sums[5]), wells);
+
+			StoreLanes(sums, first, std::min(width, batch.GetSize() - first), features);
+		}
+	}
+#endif
+
+	FeatureKernel SelectFeatureKernel()
+	{
+		for (FeatureKernel kernel : { FeatureKernel::AVX2, FeatureKernel::SSSE3 })
+		{
+			if (IsFeatureKernelSupported(kernel))
+			{
+				return kernel;
+			}
+		}
+
+		return FeatureKernel::SCALAR;
+	}
+}
+
+BoardBatch::BoardBatch() : width_(0), height_(0), size_(0), stride_(0), rows_()
+{
+}
+
+void BoardBatch::Reset(int width, int height, std::size_t capacity)
+{
+	assert(width > 1 && width <= Bitboard::max_width && height > 0 && height <= Bitboard::max_height);
+
+	width_ = width;
+	height_ = height;
+	size_ = 0;
+	stride_ = (capacity + lanes - 1) / lanes * lanes;
+	rows_.assign(stride_ * height, 0);
+}
+
+std::size_t BoardBatch::Add(const Bitboard& bitboard)
+{
+	assert(size_ < stride_ && bitboard.GetWidth() == width_ && bitboard.GetHeight() == height_);
+
+	const Bitboard::Row* rows = bitboard.GetRows();
+
+	for (int y = 0; y < height_; ++y)
+	{
+		rows_[y * stride_ + size_] = rows[y];
+	}
+
+	return size_++;
+}
+
+int BoardBatch::GetWidth() const
+{
+	return width_;
+}
+
+int BoardBatch::GetHeight() const
+{
+	return height_;
+}
+
+std::size_t BoardBatch::GetSize() const
+{
+	return size_;
+}
+
+std::size_t BoardBatch::GetStride() const
+{
+	return stride_;
+}
+
+const Bitboard::Row* BoardBatch::GetRows() const
+{
+	return rows_.data();
+}
+
+BoardFeatures ExtractBoardFeatures(const Bitboard& bitboard)
+{
+	return ExtractScalar(bitboard.GetRows(), 1, bitboard.GetWidth(), bitboard.GetHeight());
+}
+
+void ExtractBoardFeatures(const BoardBatch& batch, BoardFeatures* features, FeatureKernel kernel)
+{
+	assert(IsFeatureKernelSupported(kernel));
+
+	switch (kernel)
+	{
+#ifdef BOARD_FEATURES_X86
+	case FeatureKernel::AVX2: 
+		ExtractBatchAvx2(batch, features);
+		break;
+	case FeatureKernel::SSSE3: 
+		ExtractBatchSsse3(batch, features);
+		break;
+#endif
+	default: 
+		ExtractBatchScalar(batch, features);
+		break;
+	}
+}
+
+void ExtractBoardFeatures(const BoardBatch& batch, BoardFeatures* features)
+{
+	ExtractBoardFeatures(batch, features, GetFeatureKernel());
+}
+
+bool IsFeatureKernelSupported(FeatureKernel kernel)
+{
+	switch (kernel)
+	{
+	case FeatureKernel::SCALAR: 
+		return true;
+#ifdef BOARD_FEATURES_X86
+	case FeatureKernel::SSSE3: 
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("ssse3");
+	case FeatureKernel::AVX2: 
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+#endif
+	default: 
+		return false;
+	}
+}
+
+FeatureKernel GetFeatureKernel()
+{
+	static const FeatureKernel kernel = SelectFeatureKernel();
+
+	return kernel;
+}
+
+const char* GetFeatureKernelName(FeatureKernel kernel)
+{
+	static constexpr const char* names[] = { "scalar", "ssse3", "avx2" };
+
+	return kernel < FeatureKernel::COUNT ? names[static_cast<std::size_t>(kernel)] : "unknown";
+}
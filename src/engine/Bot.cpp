@@ -0,0 +1,531 @@
+#include "Bot.hpp"
+#include "BoardFeatures.hpp"
+#include "PieceSource.hpp"
+#include "Zobrist.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <utility>
+
+namespace
+{
+	constexpr double lost_score = -1.0e9;
+	constexpr int state_margin = 4;
+
+	constexpr std::size_t max_sequence = PieceSource::preview + 1;
+	constexpr std::array<std::uint64_t, max_sequence * rotation_tables::types> sequence_piece_keys = zobrist::MakeKeys<max_sequence * rotation_tables::types>(1);
+	constexpr std::array<std::uint64_t, max_sequence> sequence_length_keys = zobrist::MakeKeys<max_sequence>(2);
+	constexpr std::array<std::uint64_t, rotation_tables::types + 1> stash_keys = zobrist::MakeKeys<rotation_tables::types + 1>(3);
+
+	std::uint64_t GetStashKey(const std::optional<TetrominoType>& stashed_type)
+	{
+		return stash_keys[stashed_type.has_value() ? static_cast<std::size_t>(*stashed_type) + 1 : 0];
+	}
+
+	std::uint64_t GetSequenceKey(const TetrominoType* next, std::size_t remaining)
+	{
+		std::uint64_t key = sequence_length_keys[remaining];
+
+		for (std::size_t i = 0; i < remaining; ++i)
+		{
+			key ^= sequence_piece_keys[i * rotation_tables::types + static_cast<std::size_t>(next[i])];
+		}
+
+		return key;
+	}
+}
+
+Bot::Bot(const BotOptions& options, std::shared_ptr<TranspositionTable> transposition_table) : 
+	options_(options), 
+	visited_(), 
+	visit_stamp_(0), 
+	nodes_(), 
+	placements_(), 
+	boards_(), 
+	candidates_(), 
+	batch_(), 
+	batch_features_(), 
+	spawn_states_(), 
+	transposition_table_(std::move(transposition_table)), 
+	evaluated_placements_(0), 
+	cache_probes_(0), 
+	cache_hits_(0), 
+	think_seconds_(0.0)
+{
+	if (transposition_table_ == nullptr && options_.transposition_bits_ > 0)
+	{
+		transposition_table_ = std::make_shared<TranspositionTable>(options_.transposition_bits_);
+	}
+}
+
+BotWeights Bot::GetDefaultWeights()
+{
+	return { -0.510066, -0.35663, -0.184483, 0.760666, 0.0, 0.0 };
+}
+
+BotOptions Bot::GetDefaultOptions()
+{
+	return { GetDefaultWeights(), 0, false, 16 };
+}
+
+const BotOptions& Bot::GetOptions() const
+{
+	return options_;
+}
+
+void Bot::SetWeights(const BotWeights& weights)
+{
+	options_.weights_ = weights;
+
+	if (transposition_table_ != nullptr)
+	{
+		transposition_table_->Clear();
+	}
+}
+
+bool Bot::Think(const Engine& engine, BotPlan* plan)
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	const std::size_t max_lookahead = PieceSource::preview - 2;
+	const std::size_t lookahead = std::min(static_cast<std::size_t>(std::max(options_.lookahead_, 0)), max_lookahead);
+
+	placements_.resize(lookahead + 1);
+	candidates_.resize(lookahead + 1);
+	boards_.resize(lookahead + 2);
+	boards_[0] = engine.bitboard_;
+
+	for (std::size_t i = 0; i < spawn_states_.size(); ++i)
+	{
+		spawn_states_[i] = engine.GetSpawnState(static_cast<TetrominoType>(i));
+	}
+
+	std::array<TetrominoType, PieceSource::preview> queue = {};
+
+	for (std::size_t i = 0; i < lookahead + 1; ++i)
+	{
+		queue[i] = engine.GetQueuedType(i);
+	}
+
+	PieceState best = engine.GetFallingPiece();
+	double best_score = Search(0, engine.GetFallingPiece(), queue.data(), lookahead, GetStashKey(engine.GetStashedType()), &best);
+	bool stash = false;
+
+	if (options_.use_stash_ && engine.CanStash())
+	{
+		const std::optional<TetrominoType>& stashed_type = engine.GetStashedType();
+		const TetrominoType alternative = stashed_type.has_value() ? *stashed_type : queue[0];
+		const TetrominoType* next = stashed_type.has_value() ? queue.data() : queue.data() + 1;
+		const PieceState alternative_start = spawn_states_[static_cast<std::size_t>(alternative)];
+
+		PieceState alternative_best = alternative_start;
+
+		if (!alternative_start.Collides(engine.bitboard_))
+		{
+			const double alternative_score = Search(0, alternative_start, next, lookahead, GetStashKey(engine.GetFallingPiece().type_), &alternative_best);
+
+			if (alternative_score > best_score)
+			{
+				best_score = alternative_score;
+				best = alternative_best;
+				stash = true;
+			}
+		}
+	}
+
+	bool found = best_score > lost_score;
+
+	if (found)
+	{
+		plan->target_ = best;
+		plan->stash_ = stash;
+		plan->score_ = best_score;
+
+		if (stash)
+		{
+			plan->actions_.assign(1, BotAction::STASH);
+		}
+		else
+		{
+			found = FindPath(engine.bitboard_, engine.GetFallingPiece(), best, &plan->actions_);
+		}
+	}
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	think_seconds_ += elapsed.count();
+
+	return found;
+}
+
+bool Bot::FindPath(const Bitboard& bitboard, const PieceState& start, const PieceState& target, std::vector<BotAction>* actions)
+{
+	actions->clear();
+
+	std::vector<PieceState> placements;
+	Explore(bitboard, start, &placements);
+
+	int node = -1;
+
+	for (std::size_t i = 0; i < nodes_.size(); ++i)
+	{
+		if (nodes_[i].state_ == target)
+		{
+			node = static_cast<int>(i);
+			break;
+		}
+	}
+
+	if (node < 0)
+	{
+		return false;
+	}
+
+	std::vector<int> path;
+
+	for (; node >= 0; node = nodes_[node].parent_)
+	{
+		path.push_back(node);
+	}
+
+	std::reverse(path.begin(), path.end());
+
+	std::size_t drop_from = path.size() - 1;
+
+	for (std::size_t i = 0; i < path.size(); ++i)
+	{
+		if (nodes_[path[i]].state_.Dropped(bitboard) == target)
+		{
+			drop_from = i;
+			break;
+		}
+	}
+
+	for (std::size_t i = 1; i <= drop_from; ++i)
+	{
+		const SearchNode& step = nodes_[path[i]];
+		const int repeats = step.action_ == BotAction::DOWN ? step.state_.y_ - nodes_[path[i - 1]].state_.y_ : 1;
+
+		actions->insert(actions->end(), repeats, step.action_);
+	}
+
+	actions->push_back(BotAction::HARD_DROP);
+	return true;
+}
+
+std::uint64_t Bot::GetEvaluatedPlacements() const
+{
+	return evaluated_placements_;
+}
+
+double Bot::GetThinkSeconds() const
+{
+	return think_seconds_;
+}
+
+std::uint64_t Bot::GetCacheProbes() const
+{
+	return cache_probes_;
+}
+
+std::uint64_t Bot::GetCacheHits() const
+{
+	return cache_hits_;
+}
+
+std::size_t Bot::GetStateIndex(const Bitboard& bitboard, const PieceState& state) const
+{
+	const std::size_t columns = bitboard.GetWidth() + state_margin * 2;
+	const std::size_t rows = bitboard.GetHeight() + state_margin * 2;
+
+	return (state.rotation_ * columns + (state.x_ + state_margin)) * rows + (state.y_ + state_margin);
+}
+
+void Bot::Explore(const Bitboard& bitboard, const PieceState& start, std::vector<PieceState>* placements)
+{
+	const std::size_t states = rotation_tables::rotations * (bitboard.GetWidth() + state_margin * 2) * (bitboard.GetHeight() + state_margin * 2);
+
+	if (visited_.size() < states)
+	{
+		visited_.assign(states, 0);
+		visit_stamp_ = 0;
+	}
+
+	if (++visit_stamp_ == 0)
+	{
+		std::fill(visited_.begin(), visited_.end(), 0);
+		visit_stamp_ = 1;
+	}
+
+	nodes_.clear();
+	placements->clear();
+
+	if (start.Collides(bitboard))
+	{
+		return;
+	}
+
+	visited_[GetStateIndex(bitboard, start)] = visit_stamp_;
+	nodes_.push_back({ start, -1, BotAction::HARD_DROP });
+
+	for (std::size_t i = 0; i < nodes_.size(); ++i)
+	{
+		const PieceState state = nodes_[i].state_;
+		const int drop_distance = state.GetDropDistance(bitboard);
+		std::optional<PieceState> dropped;
+
+		if (drop_distance == 0)
+		{
+			placements->push_back(state);
+		}
+		else
+		{
+			dropped = state;
+			dropped->y_ = static_cast<std::int16_t>(state.y_ + drop_distance);
+		}
+
+		const std::optional<PieceState> neighbours[] = 
+		{
+			state.Moved(bitboard, -1), 
+			state.Moved(bitboard, 1), 
+			dropped, 
+			state.Rotated(bitboard, 90), 
+			state.Rotated(bitboard, 270)
+		};
+
+		constexpr BotAction actions[] = 
+		{
+			BotAction::LEFT, 
+			BotAction::RIGHT, 
+			BotAction::DOWN, 
+			BotAction::ROTATE_CLOCKWISE, 
+			BotAction::ROTATE_COUNTERCLOCKWISE
+		};
+
+		for (std::size_t j = 0; j < std::size(neighbours); ++j)
+		{
+			if (!neighbours[j].has_value())
+			{
+				continue;
+			}
+
+			const std::size_t index = GetStateIndex(bitboard, *neighbours[j]);
+
+			if (visited_[index] != visit_stamp_)
+			{
+				visited_[index] = visit_stamp_;
+				nodes_.push_back({ *neighbours[j], static_cast<int>(i), actions[j] });
+			}
+		}
+	}
+}
+
+double Bot::EvaluateBoard(const BoardFeatures& features) const
+{
+	const BotWeights& weights = options_.weights_;
+
+	return weights.aggregate_height_ * features.aggregate_height_
+		+ weights.holes_ * features.holes_
+		+ weights.bumpiness_ * features.bumpiness_
+		+ weights.row_transitions_ * features.row_transitions_
+		+ weights.wells_ * features.wells_;
+}
+
+double Bot::Search(std::size_t depth, const PieceState& start, const TetrominoType* next, std::size_t remaining, std::uint64_t stash_key, PieceState* best)
+{
+	std::vector<PieceState>& placements = placements_[depth];
+	std::vector<Candidate>& candidates = candidates_[depth];
+	Explore(boards_[depth], start, &placements);
+
+	// Scores below a placement exclude the lines it cleared, so they depend only on the resulting
+	// board, the pieces still to come and the stash, which is what the transposition key covers.
+	// Only the root tries the stash today, but keying on it keeps entries sound if deeper plies do too.
+	const std::uint64_t sequence_key = GetSequenceKey(next, remaining) ^ stash_key;
+
+	candidates.clear();
+
+	if (remaining == 0)
+	{
+		batch_.Reset(boards_[depth].GetWidth(), boards_[depth].GetHeight(), placements.size());
+	}
+
+	for (const PieceState& placement : placements)
+	{
+		Bitboard& board = boards_[depth + 1];
+		board = boards_[depth];
+		placement.Place(&board);
+
+		Candidate candidate = { 0, board.ClearFullRows(), -1, lost_score };
+		candidate.key_ = board.GetHash() ^ sequence_key;
+		++evaluated_placements_;
+
+		bool cached = false;
+
+		if (transposition_table_ != nullptr)
+		{
+			cached = transposition_table_->Probe(candidate.key_, &candidate.score_);
+			++cache_probes_;
+			cache_hits_ += cached ? 1 : 0;
+		}
+
+		if (!cached && remaining == 0)
+		{
+			candidate.batch_index_ = static_cast<int>(batch_.Add(board));
+		}
+		else if (!cached)
+		{
+			const PieceState& next_start = spawn_states_[static_cast<std::size_t>(*next)];
+
+			if (!next_start.Collides(board))
+			{
+				candidate.score_ = Search(depth + 1, next_start, next + 1, remaining - 1, stash_key, nullptr);
+			}
+
+			if (transposition_table_ != nullptr)
+			{
+				transposition_table_->Store(candidate.key_, candidate.score_);
+			}
+		}
+
+		candidates.push_back(candidate);
+	}
+
+	if (remaining == 0 && batch_.GetSize() > 0)
+	{
+		batch_features_.resize(batch_.GetSize());
+		ExtractBoardFeatures(batch_, batch_features_.data());
+
+		for (Candidate& candidate : candidates)
+		{
+			if (candidate.batch_index_ < 0)
+			{
+				continue;
+			}
+
+			candidate.score_ = EvaluateBoard(batch_features_[candidate.batch_index_]);
+
+			if (transposition_table_ != nullptr)
+			{
+				transposition_table_->Store(candidate.key_, candidate.score_);
+			}
+		}
+	}
+
+	double best_score = lost_score;
+
+	for (std::size_t i = 0; i < candidates.size(); ++i)
+	{
+		double score = candidates[i].score_;
+
+		if (score > lost_score)
+		{
+			score += options_.weights_.lines_cleared_ * candidates[i].cleared_;
+		}
+
+		if (score > best_score)
+		{
+			best_score = score;
+
+			if (best != nullptr)
+			{
+				*best = placements[i];
+			}
+		}
+	}
+
+	return best_score;
+}
+
+BotPlayer::BotPlayer(const BotOptions& options, std::shared_ptr<TranspositionTable> transposition_table) : 
+	bot_(options, std::move(transposition_table)), 
+	plan_(), 
+	next_action_(0), 
+	has_plan_(false), 
+	expected_(), 
+	board_version_(0), 
+	holding_(false), 
+	release_input_(Input::COUNT)
+{
+}
+
+void BotPlayer::Update(const Engine& engine, std::vector<Input>* inputs)
+{
+	if (holding_)
+	{
+		inputs->push_back(release_input_);
+		holding_ = false;
+	}
+
+	if (engine.IsGameOver())
+	{
+		has_plan_ = false;
+		return;
+	}
+
+	const PieceState& piece = engine.GetFallingPiece();
+
+	if (!has_plan_ || engine.GetBoardVersion() != board_version_)
+	{
+		has_plan_ = bot_.Think(engine, &plan_);
+		next_action_ = 0;
+		board_version_ = engine.GetBoardVersion();
+	}
+	else if (piece != expected_)
+	{
+		has_plan_ = bot_.FindPath(engine.bitboard_, piece, plan_.target_, &plan_.actions_) || bot_.Think(engine, &plan_);
+		next_action_ = 0;
+	}
+
+	if (!has_plan_ || next_action_ >= plan_.actions_.size())
+	{
+		return;
+	}
+
+	const BotAction action = plan_.actions_[next_action_++];
+	expected_ = piece;
+
+	switch (action)
+	{
+		case BotAction::LEFT: 
+			inputs->push_back(Input::LEFT_PRESS);
+			release_input_ = Input::LEFT_RELEASE;
+			holding_ = true;
+			expected_ = piece.Moved(engine.bitboard_, -1).value_or(piece);
+			break;
+		case BotAction::RIGHT: 
+			inputs->push_back(Input::RIGHT_PRESS);
+			release_input_ = Input::RIGHT_RELEASE;
+			holding_ = true;
+			expected_ = piece.Moved(engine.bitboard_, 1).value_or(piece);
+			break;
+		case BotAction::DOWN: 
+			inputs->push_back(Input::DOWN_PRESS);
+			release_input_ = Input::DOWN_RELEASE;
+			holding_ = true;
+			expected_ = piece.Descended(engine.bitboard_).value_or(piece);
+			break;
+		case BotAction::ROTATE_CLOCKWISE: 
+			inputs->push_back(Input::ROTATE_CLOCKWISE);
+			expected_ = piece.Rotated(engine.bitboard_, 90).value_or(piece);
+			break;
+		case BotAction::ROTATE_COUNTERCLOCKWISE: 
+			inputs->push_back(Input::ROTATE_COUNTERCLOCKWISE);
+			expected_ = piece.Rotated(engine.bitboard_, 270).value_or(piece);
+			break;
+		case BotAction::STASH: 
+			inputs->push_back(Input::STASH);
+			has_plan_ = false;
+			break;
+		case BotAction::HARD_DROP: 
+			inputs->push_back(Input::HARD_DROP);
+			has_plan_ = false;
+			break;
+	}
+}
+
+const Bot& BotPlayer::GetBot() const
+{
+	return bot_;
+}
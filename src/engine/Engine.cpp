@@ -0,0 +1,561 @@
+#include "Engine.hpp"
+#include "RotationTables.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+Engine::Engine(int cells_width, int cells_height, std::uint32_t seed, PieceSourceMode piece_source_mode) : 
+	ticks_(0), 
+	shift_direction_(0), 
+	shift_ticks_(0), 
+	drop_ticks_(0), 
+	score_(0), 
+	lines_(0), 
+	descend_ms_(1000), 
+	tick_rate_(default_tick_rate), 
+	descend_ticks_(0), 
+	das_ticks_(0), 
+	arr_ticks_(0), 
+	game_over_(false), 
+	moving_left_(false), 
+	moving_right_(false), 
+	moving_down_(false), 
+	unstash_possible_(false), 
+	board_version_(0), 
+	last_cleared_lines_(), 
+	handling_(GetDefaultHandling()), 
+	piece_source_(piece_source_mode, seed), 
+	stashed_type_(), 
+	falling_piece_(), 
+	falling_drop_distance_(0), 
+	cells_width_(cells_width), 
+	cells_height_(cells_height), 
+	cell_types_(), 
+	bitboard_()
+{
+	assert(cells_width_ >= min_cells_width && cells_width_ <= Bitboard::max_width && cells_height_ >= min_cells_height && cells_height_ <= Bitboard::max_height);
+
+	UpdateTiming();
+	bitboard_.Resize(cells_width_, cells_height_);
+	SpawnTetromino(piece_source_.Peek(0));
+}
+
+void Engine::SetFallingPiece(const PieceState& piece)
+{
+	falling_piece_ = piece;
+	falling_drop_distance_ = piece.GetDropDistance(bitboard_);
+}
+
+bool Engine::DescendFallingPiece(int* score)
+{
+	if (falling_drop_distance_ == 0)
+	{
+		return false;
+	}
+
+	if (score != nullptr)
+	{
+		++(*score);
+	}
+
+	++falling_piece_.y_;
+	--falling_drop_distance_;
+
+	return true;
+}
+
+bool Engine::ShiftFallingPiece(int dx)
+{
+	if (const std::optional<PieceState> moved = falling_piece_.Moved(bitboard_, dx))
+	{
+		SetFallingPiece(*moved);
+		return true;
+	}
+
+	return false;
+}
+
+void Engine::RepeatShift()
+{
+	if (shift_ticks_ > 0)
+	{
+		--shift_ticks_;
+		return;
+	}
+
+	if (arr_ticks_ == 0)
+	{
+		while (ShiftFallingPiece(shift_direction_))
+		{
+		}
+	}
+	else
+	{
+		ShiftFallingPiece(shift_direction_);
+	}
+
+	shift_ticks_ = arr_ticks_ - 1;
+}
+
+void Engine::SoftDropFallingPiece()
+{
+	if (!DescendFallingPiece(&score_))
+	{
+		SettleTetromino();
+	}
+
+	drop_ticks_ = GetSoftDropInterval() - 1;
+}
+
+int Engine::GetSoftDropInterval() const
+{
+	return std::max(1, descend_ticks_ / handling_.soft_drop_factor_);
+}
+
+int Engine::ToTicks(int ms) const
+{
+	const int ticks = static_cast<int>((static_cast<std::int64_t>(ms) * tick_rate_ + 500) / 1000);
+
+	return ms > 0 ? std::max(1, ticks) : 0;
+}
+
+void Engine::UpdateTiming()
+{
+	descend_ticks_ = ToTicks(descend_ms_);
+	das_ticks_ = ToTicks(handling_.das_ms_);
+	arr_ticks_ = ToTicks(handling_.arr_ms_);
+}
+
+HandlingOptions Engine::GetDefaultHandling()
+{
+	return { 83, 83, 12 };
+}
+
+void Engine::Reset()
+{
+	stashed_type_.reset();
+
+	bitboard_.Clear();
+	++board_version_;
+	last_cleared_lines_ = {};
+
+	piece_source_.Discard();
+
+	ticks_ = 0;
+	shift_direction_ = 0;
+	shift_ticks_ = 0;
+	drop_ticks_ = 0;
+	score_ = 0;
+	lines_ = 0;
+	descend_ms_ = 1000;
+	descend_ticks_ = ToTicks(descend_ms_);
+	moving_left_ = false;
+	moving_right_ = false;
+	moving_down_ = false;
+	unstash_possible_ = false;
+	game_over_ = false;
+
+	SpawnTetromino(piece_source_.Peek(0));
+}
+
+void Engine::Tick()
+{
+	if (game_over_)
+	{
+		return;
+	}
+
+	++ticks_;
+
+	if (!moving_down_ && ticks_ % descend_ticks_ == 0)
+	{
+		if (!DescendFallingPiece(nullptr))
+		{
+			SettleTetromino();
+		}
+	}
+
+	if (shift_direction_ != 0)
+	{
+		RepeatShift();
+	}
+
+	if (moving_down_)
+	{
+		if (drop_ticks_ > 0)
+		{
+			--drop_ticks_;
+		}
+		else
+		{
+			SoftDropFallingPiece();
+		}
+	}
+}
+
+void Engine::ApplyInput(Input input)
+{
+	switch (input)
+	{
+		case Input::ROTATE_CLOCKWISE:
+			RotateTetromino(90);
+			break;
+		case Input::ROTATE_COUNTERCLOCKWISE:
+			RotateTetromino(270);
+			break;
+		case Input::LEFT_PRESS:
+			SetMovingLeft(true);
+			break;
+		case Input::LEFT_RELEASE:
+			SetMovingLeft(false);
+			break;
+		case Input::RIGHT_PRESS:
+			SetMovingRight(true);
+			break;
+		case Input::RIGHT_RELEASE:
+			SetMovingRight(false);
+			break;
+		case Input::DOWN_PRESS:
+			SetMovingDown(true);
+			break;
+		case Input::DOWN_RELEASE:
+			SetMovingDown(false);
+			break;
+		case Input::HARD_DROP:
+			HardDropTetromino();
+			break;
+		case Input::STASH:
+			TriggerStashTetromino();
+			break;
+		case Input::RESET:
+			Reset();
+			break;
+		default:
+			break;
+	}
+}
+
+void Engine::RotateTetromino(int degrees)
+{
+	if (game_over_)
+	{
+		return;
+	}
+
+	if (const std::optional<PieceState> rotated = falling_piece_.Rotated(bitboard_, degrees))
+	{
+		SetFallingPiece(*rotated);
+	}
+}
+
+void Engine::SetMovingLeft(bool moving)
+{
+	if (game_over_)
+	{
+		return;
+	}
+
+	moving_left_ = moving;
+
+	if (moving)
+	{
+		shift_direction_ = -1;
+		shift_ticks_ = das_ticks_;
+		ShiftFallingPiece(shift_direction_);
+	}
+	else if (shift_direction_ < 0)
+	{
+		shift_direction_ = moving_right_ ? 1 : 0;
+		shift_ticks_ = das_ticks_;
+	}
+}
+
+void Engine::SetMovingRight(bool moving)
+{
+	if (game_over_)
+	{
+		return;
+	}
+
+	moving_right_ = moving;
+
+	if (moving)
+	{
+		shift_direction_ = 1;
+		shift_ticks_ = das_ticks_;
+		ShiftFallingPiece(shift_direction_);
+	}
+	else if (shift_direction_ > 0)
+	{
+		shift_direction_ = moving_left_ ? -1 : 0;
+		shift_ticks_ = das_ticks_;
+	}
+}
+
+void Engine::SetMovingDown(bool moving)
+{
+	if (game_over_)
+	{
+		return;
+	}
+
+	if (moving && !moving_down_)
+	{
+		SoftDropFallingPiece();
+		drop_ticks_ = GetSoftDropInterval();
+	}
+
+	moving_down_ = moving;
+}
+
+void Engine::HardDropTetromino()
+{
+	if (!game_over_)
+	{
+		SettleTetromino(&score_);
+	}
+}
+
+void Engine::TriggerStashTetromino()
+{
+	if (game_over_)
+	{
+		return;
+	}
+
+	if (!stashed_type_.has_value())
+	{
+		stashed_type_ = falling_piece_.type_;
+		unstash_possible_ = false;
+		SpawnTetromino(piece_source_.Peek(0));
+	}
+	else if (unstash_possible_)
+	{
+		const TetrominoType unstashed_type = *stashed_type_;
+		stashed_type_ = falling_piece_.type_;
+		unstash_possible_ = false;
+		SpawnTetromino(unstashed_type, true);
+	}
+}
+
+bool Engine::PlacePiece(const PieceState& piece)
+{
+	if (game_over_ || piece.type_ != falling_piece_.type_ || piece.Collides(bitboard_))
+	{
+		return false;
+	}
+
+	SetFallingPiece(piece);
+	SettleTetromino(&score_);
+
+	return true;
+}
+
+void Engine::SetHandling(const HandlingOptions& handling)
+{
+	handling_ = { std::max(0, handling.das_ms_), std::max(0, handling.arr_ms_), std::max(1, handling.soft_drop_factor_) };
+	UpdateTiming();
+}
+
+const HandlingOptions& Engine::GetHandling() const
+{
+	return handling_;
+}
+
+void Engine::SetTickRate(int ticks_per_second)
+{
+	tick_rate_ = std::max(1, ticks_per_second);
+	UpdateTiming();
+}
+
+int Engine::GetTickRate() const
+{
+	return tick_rate_;
+}
+
+int Engine::GetTicks() const
+{
+	return ticks_;
+}
+
+int Engine::GetScore() const
+{
+	return score_;
+}
+
+int Engine::GetLines() const
+{
+	return lines_;
+}
+
+bool Engine::IsGameOver() const
+{
+	return game_over_;
+}
+
+std::uint32_t Engine::GetSeed() const
+{
+	return piece_source_.GetSeed();
+}
+
+std::uint64_t Engine::GetBoardVersion() const
+{
+	return board_version_;
+}
+
+std::uint64_t Engine::GetBoardHash() const
+{
+	constexpr std::uint64_t fnv_offset_basis = 14695981039346656037ull;
+	constexpr std::uint64_t fnv_prime = 1099511628211ull;
+
+	std::uint64_t hash = fnv_offset_basis;
+
+	for (int y = 0; y < cells_height_; ++y)
+	{
+		for (int x = 0; x < cells_width_; ++x)
+		{
+			const std::uint64_t value = bitboard_.IsOccupied(x, y) ? static_cast<std::uint64_t>(cell_types_[y * cells_width_ + x]) + 1 : 0;
+			hash = (hash ^ value) * fnv_prime;
+		}
+	}
+
+	return hash;
+}
+
+const ClearedLines& Engine::GetLastClearedLines() const
+{
+	return last_cleared_lines_;
+}
+
+const PieceState& Engine::GetFallingPiece() const
+{
+	return falling_piece_;
+}
+
+int Engine::GetFallingDropDistance() const
+{
+	return falling_drop_distance_;
+}
+
+const std::optional<TetrominoType>& Engine::GetStashedType() const
+{
+	return stashed_type_;
+}
+
+bool Engine::CanStash() const
+{
+	return !game_over_ && (!stashed_type_.has_value() || unstash_possible_);
+}
+
+TetrominoType Engine::GetQueuedType(std::size_t index) const
+{
+	return piece_source_.Peek(index);
+}
+
+const PieceSource& Engine::GetPieceSource() const
+{
+	return piece_source_;
+}
+
+PieceState Engine::GetSpawnState(TetrominoType type) const
+{
+	const int bbox_side_size = rotation_tables::dimensions[static_cast<std::size_t>(type)];
+
+	return PieceState::Spawn(type, (cells_width_ / 2) - (bbox_side_size / 2) - 1, 0);
+}
+
+void Engine::SpawnTetromino(TetrominoType type, bool unstashing)
+{
+	const PieceState spawn_state = GetSpawnState(type);
+	const std::size_t bbox_side_size = rotation_tables::dimensions[static_cast<std::size_t>(type)];
+
+	SetFallingPiece(spawn_state);
+
+	if (!unstashing)
+	{
+		piece_source_.Next();
+	}
+
+	const Bitboard::Row spawn_row_mask = static_cast<Bitboard::Row>(((1u << bbox_side_size) - 1) << spawn_state.x_);
+
+	if ((bitboard_.GetRow(0) & spawn_row_mask) != 0)
+	{
+		game_over_ = true;
+	}
+}
+
+void Engine::SettleTetromino(int* score_)
+{
+	falling_piece_.y_ = static_cast<std::int16_t>(falling_piece_.y_ + falling_drop_distance_);
+
+	if (score_ != nullptr)
+	{
+		*score_ += falling_drop_distance_;
+	}
+
+	falling_drop_distance_ = 0;
+
+	for (const rotation_tables::Offset& offset : falling_piece_.GetShape())
+	{
+		const int x = falling_piece_.x_ + offset.x;
+		const int y = falling_piece_.y_ + offset.y;
+
+		bitboard_.SetOccupied(x, y, true);
+		cell_types_[y * cells_width_ + x] = falling_piece_.type_;
+	}
+
+	ClearFilledLines();
+	++board_version_;
+	SpawnTetromino(piece_source_.Peek(0));
+	unstash_possible_ = stashed_type_.has_value();
+}
+
+void Engine::ClearFilledLines()
+{
+	last_cleared_lines_ = {};
+
+	int write_row = cells_height_ - 1;
+	int read_row = cells_height_ - 1;
+
+	for (; read_row >= 0; --read_row)
+	{
+		const Bitboard::Row row = bitboard_.GetRow(read_row);
+
+		if (row == 0)
+		{
+			break;
+		}
+
+		if (row == bitboard_.GetFullRow())
+		{
+			assert(last_cleared_lines_.count_ < static_cast<int>(last_cleared_lines_.rows_.size()));
+			last_cleared_lines_.rows_[last_cleared_lines_.count_++] = read_row;
+			continue;
+		}
+
+		if (write_row != read_row)
+		{
+			std::copy_n(cell_types_.begin() + read_row * cells_width_, cells_width_, cell_types_.begin() + write_row * cells_width_);
+			bitboard_.SetRow(write_row, row);
+		}
+
+		--write_row;
+	}
+
+	for (int i = write_row; i > read_row; --i)
+	{
+		bitboard_.SetRow(i, 0);
+	}
+
+	for (int i = 0; i < last_cleared_lines_.count_; ++i)
+	{
+		score_ += 100;
+		++lines_;
+
+		if (lines_ % 10 == 0 && descend_ms_ > 167)
+		{
+			descend_ms_ -= 167;
+			descend_ticks_ = ToTicks(descend_ms_);
+		}
+	}
+}
@@ -0,0 +1,229 @@
+#include "GameServer.hpp"
+#include "Constants.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+GameInstance::GameInstance(std::uint32_t seed, std::uint32_t input_seed, PieceSourceMode piece_source_mode, const BotOptions* bot_options, std::shared_ptr<TranspositionTable> transposition_table) : 
+	engine_(std::make_unique<Engine>(constants::board_cells_width, constants::board_cells_height, seed, piece_source_mode)), 
+	input_generator_(input_seed), 
+	bot_player_(bot_options != nullptr ? std::make_unique<BotPlayer>(*bot_options, std::move(transposition_table)) : nullptr), 
+	bot_inputs_(), 
+	tick_(0), 
+	games_(0), 
+	lines_(0), 
+	score_(0)
+{
+}
+
+void GameInstance::Step(std::uint64_t ticks)
+{
+	for (std::uint64_t i = 0; i < ticks; ++i, ++tick_)
+	{
+		if (bot_player_ != nullptr)
+		{
+			bot_player_->Update(*engine_, &bot_inputs_);
+
+			for (Input input : bot_inputs_)
+			{
+				engine_->ApplyInput(input);
+			}
+
+			bot_inputs_.clear();
+		}
+		else
+		{
+			Input input = Input::COUNT;
+
+			if (ChooseRandomInput(input_generator_, &input))
+			{
+				engine_->ApplyInput(input);
+			}
+		}
+
+		if (engine_->IsGameOver())
+		{
+			lines_ += engine_->GetLines();
+			score_ += engine_->GetScore();
+			++games_;
+			engine_->Reset();
+		}
+
+		engine_->Tick();
+	}
+}
+
+const Engine& GameInstance::GetEngine() const
+{
+	return *engine_;
+}
+
+const BotPlayer* GameInstance::GetBotPlayer() const
+{
+	return bot_player_.get();
+}
+
+std::uint64_t GameInstance::GetTick() const
+{
+	return tick_;
+}
+
+std::uint64_t GameInstance::GetGames() const
+{
+	return games_;
+}
+
+std::uint64_t GameInstance::GetLines() const
+{
+	return lines_ + static_cast<std::uint64_t>(engine_->GetLines());
+}
+
+std::uint64_t GameInstance::GetScore() const
+{
+	return score_ + static_cast<std::uint64_t>(engine_->GetScore());
+}
+
+GameServer::GameServer(const GameServerOptions& options) : 
+	options_(options), 
+	thread_pool_(std::make_unique<ThreadPool>(options.threads_)), 
+	transposition_table_(options.bot_ && options.bot_options_.transposition_bits_ > 0 ? std::make_shared<TranspositionTable>(options.bot_options_.transposition_bits_) : nullptr), 
+	instances_()
+{
+	if (options_.chunk_ticks_ == 0)
+	{
+		options_.chunk_ticks_ = 1;
+	}
+
+	for (std::size_t i = 0; i < options_.games_; ++i)
+	{
+		const std::uint32_t offset = static_cast<std::uint32_t>(i);
+		instances_.push_back(std::make_unique<GameInstance>(options_.seed_ + offset, options_.input_seed_ + offset, options_.piece_source_mode_, options_.bot_ ? &options_.bot_options_ : nullptr, transposition_table_));
+	}
+}
+
+void GameServer::StepInstance(std::size_t index)
+{
+	GameInstance& instance = *instances_[index];
+	const std::uint64_t remaining = options_.ticks_ - instance.GetTick();
+
+	instance.Step(std::min(remaining, options_.chunk_ticks_));
+
+	if (instance.GetTick() < options_.ticks_)
+	{
+		thread_pool_->Submit([this, index]() { StepInstance(index); });
+	}
+}
+
+void GameServer::Run()
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	for (std::size_t i = 0; i < instances_.size(); ++i)
+	{
+		if (instances_[i]->GetTick() < options_.ticks_)
+		{
+			thread_pool_->Submit([this, i]() { StepInstance(i); });
+		}
+	}
+
+	thread_pool_->Wait();
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::uint64_t games = 0;
+	std::uint64_t lines = 0;
+	std::uint64_t score = 0;
+
+	for (const std::unique_ptr<GameInstance>& instance : instances_)
+	{
+		games += instance->GetGames();
+		lines += instance->GetLines();
+		score += instance->GetScore();
+	}
+
+	const double total_ticks = static_cast<double>(options_.ticks_) * instances_.size();
+
+	printf("Instances: %llu, Threads: %llu, Ticks per instance: %llu\n", 
+		static_cast<unsigned long long>(instances_.size()), 
+		static_cast<unsigned long long>(thread_pool_->GetThreadCount()), 
+		static_cast<unsigned long long>(options_.ticks_));
+	printf("Games: %llu, Lines: %llu, Score: %llu, Combined hash: %016llx\n", 
+		static_cast<unsigned long long>(games), 
+		static_cast<unsigned long long>(lines), 
+		static_cast<unsigned long long>(score), 
+		static_cast<unsigned long long>(GetCombinedHash()));
+	printf("Elapsed: %.3f s, Ticks per second: %.0f, Steals: %llu\n", 
+		elapsed.count(), 
+		elapsed.count() > 0.0 ? total_ticks / elapsed.count() : 0.0, 
+		static_cast<unsigned long long>(thread_pool_->GetSteals()));
+
+	if (options_.bot_)
+	{
+		std::uint64_t placements = 0;
+		double think_seconds = 0.0;
+		std::uint64_t probes = 0;
+		std::uint64_t hits = 0;
+
+		for (const std::unique_ptr<GameInstance>& instance : instances_)
+		{
+			placements += instance->GetBotPlayer()->GetBot().GetEvaluatedPlacements();
+			think_seconds += instance->GetBotPlayer()->GetBot().GetThinkSeconds();
+			probes += instance->GetBotPlayer()->GetBot().GetCacheProbes();
+			hits += instance->GetBotPlayer()->GetBot().GetCacheHits();
+		}
+
+		printf("Placements evaluated: %llu, Placements per second per thread: %.0f\n", 
+			static_cast<unsigned long long>(placements), 
+			think_seconds > 0.0 ? placements / think_seconds : 0.0);
+		printf("Cache probes: %llu, Cache hits: %.1f%%\n", 
+			static_cast<unsigned long long>(probes), 
+			probes > 0 ? 100.0 * hits / probes : 0.0);
+	}
+}
+
+const GameInstance& GameServer::GetInstance(std::size_t index) const
+{
+	return *instances_[index];
+}
+
+std::uint64_t GameServer::GetCombinedHash() const
+{
+	constexpr std::uint64_t fnv_offset_basis = 14695981039346656037ull;
+	constexpr std::uint64_t fnv_prime = 1099511628211ull;
+
+	std::uint64_t hash = fnv_offset_basis;
+
+	for (const std::unique_ptr<GameInstance>& instance : instances_)
+	{
+		hash = (hash ^ instance->GetEngine().GetBoardHash()) * fnv_prime;
+		hash = (hash ^ static_cast<std::uint64_t>(instance->GetEngine().GetScore())) * fnv_prime;
+	}
+
+	return hash;
+}
+
+bool ChooseRandomInput(std::mt19937& generator, Input* input)
+{
+	const std::uint32_t choice = generator() % 16;
+
+	if (choice >= 7)
+	{
+		return false;
+	}
+
+	constexpr Input random_inputs[7] = 
+	{
+		Input::ROTATE_CLOCKWISE, 
+		Input::LEFT_PRESS, 
+		Input::LEFT_RELEASE, 
+		Input::RIGHT_PRESS, 
+		Input::RIGHT_RELEASE, 
+		Input::HARD_DROP, 
+		Input::STASH
+	};
+
+	*input = random_inputs[choice];
+	return true;
+}
@@ -0,0 +1,145 @@
+#include "PieceSource.hpp"
+#include "RotationTables.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+PieceSource::PieceSource(PieceSourceMode mode, std::uint32_t seed) : 
+	mode_(mode), 
+	seed_(seed), 
+	generator_(seed), 
+	bag_(), 
+	ring_(), 
+	head_(0), 
+	count_(0), 
+	generated_(0), 
+	consumed_(0)
+{
+	assert(mode_ < PieceSourceMode::COUNT);
+
+	for (std::size_t i = 0; i < bag_.size(); ++i)
+	{
+		bag_[i] = static_cast<TetrominoType>(i % rotation_tables::types);
+	}
+
+	Refill();
+}
+
+PieceSourceMode PieceSource::GetMode() const
+{
+	return mode_;
+}
+
+std::uint32_t PieceSource::GetSeed() const
+{
+	return seed_;
+}
+
+TetrominoType PieceSource::Peek(std::size_t index) const
+{
+	assert(index < count_);
+	return ring_[(head_ + index) % capacity];
+}
+
+TetrominoType PieceSource::Next()
+{
+	const TetrominoType type = ring_[head_];
+
+	head_ = (head_ + 1) % capacity;
+	--count_;
+	++consumed_;
+	Refill();
+
+	return type;
+}
+
+void PieceSource::Discard()
+{
+	head_ = (head_ + count_) % capacity;
+	consumed_ += count_;
+	count_ = 0;
+	Refill();
+}
+
+PieceSourceState PieceSource::GetState() const
+{
+	return { mode_, seed_, generated_, consumed_ };
+}
+
+void PieceSource::Restore(const PieceSourceState& state)
+{
+	assert(state.consumed_ <= state.generated_);
+
+	*this = PieceSource(state.mode_, state.seed_);
+
+	while (consumed_ < state.consumed_)
+	{
+		Next();
+	}
+
+	while (generated_ < state.generated_)
+	{
+		GenerateBag();
+	}
+}
+
+void PieceSource::Push(TetrominoType type)
+{
+	assert(count_ < capacity);
+
+	ring_[(head_ + count_) % capacity] = type;
+	++count_;
+	++generated_;
+}
+
+void PieceSource::GenerateBag()
+{
+	if (mode_ == PieceSourceMode::CLASSIC)
+	{
+		Push(static_cast<TetrominoType>(generator_() % rotation_tables::types));
+		return;
+	}
+
+	const std::size_t bag_size = mode_ == PieceSourceMode::FOURTEEN_BAG ? 14 : 7;
+
+	// Hand-rolled Fisher-Yates: std::shuffle differs between standard libraries, which would break replays.
+	for (std::size_t i = bag_size - 1; i > 0; --i)
+	{
+		std::swap(bag_[i], bag_[generator_() % (i + 1)]);
+	}
+
+	for (std::size_t i = 0; i < bag_size; ++i)
+	{
+		Push(bag_[i]);
+	}
+}
+
+void PieceSource::Refill()
+{
+	while (count_ < preview)
+	{
+		GenerateBag();
+	}
+}
+
+const char* PieceSource::GetModeName(PieceSourceMode mode)
+{
+	constexpr const char* names[] = { "7bag", "14bag", "classic" };
+
+	return mode < PieceSourceMode::COUNT ? names[static_cast<std::size_t>(mode)] : "unknown";
+}
+
+bool PieceSource::ParseMode(const char* name, PieceSourceMode* mode)
+{
+	for (std::size_t i = 0; i < static_cast<std::size_t>(PieceSourceMode::COUNT); ++i)
+	{
+		if (std::strcmp(name, GetModeName(static_cast<PieceSourceMode>(i))) == 0)
+		{
+			*mode = static_cast<PieceSourceMode>(i);
+			return true;
+		}
+	}
+
+	return false;
+}
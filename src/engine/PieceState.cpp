@@ -0,0 +1,167 @@
+#include "PieceState.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+PieceState PieceState::Spawn(TetrominoType type, int x, int y)
+{
+	const int spawn_y = y + rotation_tables::spawn_offsets_y[static_cast<std::size_t>(type)];
+
+	return { type, 0, static_cast<std::int16_t>(x), static_cast<std::int16_t>(spawn_y) };
+}
+
+const rotation_tables::Shape& PieceState::GetShape() const
+{
+	return rotation_tables::shapes[static_cast<std::size_t>(type_)][rotation_];
+}
+
+const Bitboard::PieceRows& PieceState::GetMask() const
+{
+	return rotation_tables::masks[static_cast<std::size_t>(type_)][rotation_];
+}
+
+bool PieceState::Collides(const Bitboard& bitboard) const
+{
+	return bitboard.Collides(GetMask(), x_, y_);
+}
+
+int PieceState::GetDropDistance(const Bitboard& bitboard) const
+{
+	const std::array<int, 4>& column_bottoms = rotation_tables::column_bottoms[static_cast<std::size_t>(type_)][rotation_];
+	const Bitboard::PieceRows& mask = GetMask();
+
+	int drop_distance = bitboard.GetHeight();
+
+	for (std::size_t i = 0; i < column_bottoms.size(); ++i)
+	{
+		if (column_bottoms[i] < 0)
+		{
+			continue;
+		}
+
+		const int bottom = y_ + column_bottoms[i];
+		const int top = bitboard.GetColumnTop(x_ + static_cast<int>(i));
+
+		if (bottom >= top)
+		{
+			int drop_y = y_;
+
+			while (!bitboard.Collides(mask, x_, drop_y + 1))
+			{
+				++drop_y;
+			}
+
+			return drop_y - y_;
+		}
+
+		drop_distance = std::min(drop_distance, top - 1 - bottom);
+	}
+
+	return drop_distance;
+}
+
+std::optional<PieceState> PieceState::Moved(const Bitboard& bitboard, int dx) const
+{
+	PieceState moved = *this;
+	moved.x_ = static_cast<std::int16_t>(x_ + dx);
+
+	if (moved.Collides(bitboard))
+	{
+		return std::nullopt;
+	}
+
+	return moved;
+}
+
+std::optional<PieceState> PieceState::Descended(const Bitboard& bitboard) const
+{
+	PieceState descended = *this;
+	descended.y_ = static_cast<std::int16_t>(y_ + 1);
+
+	if (descended.Collides(bitboard))
+	{
+		return std::nullopt;
+	}
+
+	return descended;
+}
+
+std::optional<PieceState> PieceState::Rotated(const Bitboard& bitboard, int degrees) const
+{
+	assert(degrees % 90 == 0);
+
+	const std::size_t type_index = static_cast<std::size_t>(type_);
+	const int quarter_turns = ((degrees / 90) % 4 + 4) % 4;
+
+	if (quarter_turns == 0 || type_ == TetrominoType::O_BLOCK)
+	{
+		return std::nullopt;
+	}
+
+	const int target_rotation = (rotation_ + quarter_turns) % 4;
+	const Bitboard::PieceRows& target_mask = rotation_tables::masks[type_index][target_rotation];
+
+	for (std::size_t i = 0; i < rotation_tables::kicks; ++i)
+	{
+		rotation_tables::Offset kick = { 0, 0 };
+
+		if (quarter_turns == 1)
+		{
+			kick = rotation_tables::clockwise_kicks[type_index][rotation_][i];
+		}
+		else if (quarter_turns == 3)
+		{
+			const rotation_tables::Offset& clockwise_kick = rotation_tables::clockwise_kicks[type_index][target_rotation][i];
+			kick = { -clockwise_kick.x, -clockwise_kick.y };
+		}
+		else if (i > 0)
+		{
+			break;
+		}
+
+		if (!bitboard.Collides(target_mask, x_ + kick.x, y_ + kick.y))
+		{
+			return PieceState{ type_, static_cast<std::uint8_t>(target_rotation), static_cast<std::int16_t>(x_ + kick.x), static_cast<std::int16_t>(y_ + kick.y) };
+		}
+	}
+
+	return std::nullopt;
+}
+
+PieceState PieceState::Dropped(const Bitboard& bitboard) const
+{
+	PieceState dropped = *this;
+	dropped.y_ = static_cast<std::int16_t>(y_ + GetDropDistance(bitboard));
+
+	return dropped;
+}
+
+void PieceState::Place(Bitboard* bitboard) const
+{
+	assert(!Collides(*bitboard));
+
+	const Bitboard::PieceRows& mask = GetMask();
+
+	for (std::size_t i = 0; i < mask.size(); ++i)
+	{
+		if (mask[i] == 0)
+		{
+			continue;
+		}
+
+		const int y = y_ + static_cast<int>(i);
+		const Bitboard::Row shifted = static_cast<Bitboard::Row>(x_ >= 0 ? mask[i] << x_ : mask[i] >> -x_);
+
+		bitboard->SetRow(y, bitboard->GetRow(y) | shifted);
+	}
+}
+
+bool operator==(const PieceState& lhs, const PieceState& rhs)
+{
+	return lhs.type_ == rhs.type_ && lhs.rotation_ == rhs.rotation_ && lhs.x_ == rhs.x_ && lhs.y_ == rhs.y_;
+}
+
+bool operator!=(const PieceState& lhs, const PieceState& rhs)
+{
+	return !(lhs == rhs);
+}
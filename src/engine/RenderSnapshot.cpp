@@ -0,0 +1,36 @@
+#include "RenderSnapshot.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+void RenderSnapshot::Capture(const Engine& engine, std::uint64_t tick, std::uint64_t published, const PieceState& previous_piece)
+{
+	assert(engine.cells_width_ <= Bitboard::max_width && engine.cells_height_ <= Bitboard::max_height);
+
+	tick_ = tick;
+	published_ = published;
+
+	if (board_version_ != engine.GetBoardVersion() || cells_width_ != engine.cells_width_ || cells_height_ != engine.cells_height_)
+	{
+		board_version_ = engine.GetBoardVersion();
+		cells_width_ = engine.cells_width_;
+		cells_height_ = engine.cells_height_;
+
+		std::copy_n(engine.bitboard_.GetRows(), cells_height_, rows_.begin());
+		std::copy_n(engine.cell_types_.begin(), cells_width_ * cells_height_, cell_types_.begin());
+	}
+
+	falling_piece_ = engine.GetFallingPiece();
+	previous_piece_ = previous_piece;
+	falling_drop_distance_ = engine.GetFallingDropDistance();
+	stashed_type_ = engine.GetStashedType();
+
+	for (std::size_t i = 0; i < queued_types_.size(); ++i)
+	{
+		queued_types_[i] = engine.GetQueuedType(i);
+	}
+
+	score_ = engine.GetScore();
+	lines_ = engine.GetLines();
+	game_over_ = engine.IsGameOver();
+}
@@ -0,0 +1,298 @@
+#include "Replay.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace
+{
+	constexpr char replay_magic[4] = { 'T', 'T', 'R', 'P' };
+	constexpr std::uint8_t replay_version = 4;
+
+	void WriteVarint(std::vector<std::uint8_t>* buffer, std::uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			buffer->push_back(static_cast<std::uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+
+		buffer->push_back(static_cast<std::uint8_t>(value));
+	}
+
+	void WriteFixed(std::vector<std::uint8_t>* buffer, std::uint64_t value, int bytes)
+	{
+		for (int i = 0; i < bytes; ++i)
+		{
+			buffer->push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+		}
+	}
+
+	bool ReadVarint(const std::vector<std::uint8_t>& buffer, std::size_t* offset, std::uint64_t* value)
+	{
+		*value = 0;
+
+		for (int shift = 0; shift < 64; shift += 7)
+		{
+			if (*offset >= buffer.size())
+			{
+				return false;
+			}
+
+			const std::uint8_t byte = buffer[(*offset)++];
+			*value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+
+			if ((byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool ReadFixed(const std::vector<std::uint8_t>& buffer, std::size_t* offset, std::uint64_t* value, int bytes)
+	{
+		if (*offset + bytes > buffer.size())
+		{
+			return false;
+		}
+
+		*value = 0;
+
+		for (int i = 0; i < bytes; ++i)
+		{
+			*value |= static_cast<std::uint64_t>(buffer[(*offset)++]) << (i * 8);
+		}
+
+		return true;
+	}
+}
+
+Replay::Replay() : 
+	cells_width_(0), 
+	cells_height_(0), 
+	seed_(0), 
+	piece_source_mode_(PieceSourceMode::SEVEN_BAG), 
+	handling_(Engine::GetDefaultHandling()), 
+	tick_rate_(Engine::default_tick_rate), 
+	final_ticks_(0), 
+	final_score_(0), 
+	final_lines_(0), 
+	final_board_hash_(0), 
+	next_event_(0)
+{
+}
+
+void Replay::Start(const Engine& engine)
+{
+	cells_width_ = engine.cells_width_;
+	cells_height_ = engine.cells_height_;
+	seed_ = engine.GetSeed();
+	piece_source_mode_ = engine.GetPieceSource().GetMode();
+	handling_ = engine.GetHandling();
+	tick_rate_ = engine.GetTickRate();
+	events_.clear();
+	next_event_ = 0;
+}
+
+void Replay::Record(std::uint64_t tick, Input input)
+{
+	assert(events_.empty() || events_.back().tick_ <= tick);
+	events_.push_back({ tick, input });
+}
+
+void Replay::Finish(const Engine& engine, std::uint64_t ticks)
+{
+	final_ticks_ = ticks;
+	final_score_ = engine.GetScore();
+	final_lines_ = engine.GetLines();
+	final_board_hash_ = engine.GetBoardHash();
+}
+
+bool Replay::Save(const std::string& path) const
+{
+	std::vector<std::uint8_t> buffer(std::begin(replay_magic), std::end(replay_magic));
+
+	buffer.push_back(replay_version);
+	WriteVarint(&buffer, static_cast<std::uint64_t>(cells_width_));
+	WriteVarint(&buffer, static_cast<std::uint64_t>(cells_height_));
+	WriteFixed(&buffer, seed_, 4);
+	buffer.push_back(static_cast<std::uint8_t>(piece_source_mode_));
+	WriteVarint(&buffer, static_cast<std::uint64_t>(tick_rate_));
+	WriteVarint(&buffer, static_cast<std::uint64_t>(handling_.das_ms_));
+	WriteVarint(&buffer, static_cast<std::uint64_t>(handling_.arr_ms_));
+	WriteVarint(&buffer, static_cast<std::uint64_t>(handling_.soft_drop_factor_));
+	WriteVarint(&buffer, events_.size());
+
+	std::uint64_t previous_tick = 0;
+
+	for (const ReplayEvent& event : events_)
+	{
+		WriteVarint(&buffer, event.tick_ - previous_tick);
+		buffer.push_back(static_cast<std::uint8_t>(event.input_));
+		previous_tick = event.tick_;
+	}
+
+	WriteVarint(&buffer, final_ticks_);
+	WriteVarint(&buffer, static_cast<std::uint64_t>(final_score_));
+	WriteVarint(&buffer, static_cast<std::uint64_t>(final_lines_));
+	WriteFixed(&buffer, final_board_hash_, 8);
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	if (!file)
+	{
+		printf("Unable to open replay file '%s' for writing!\n", path.c_str());
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+	return static_cast<bool>(file);
+}
+
+bool Replay::Load(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file)
+	{
+		printf("Unable to open replay file '%s'!\n", path.c_str());
+		return false;
+	}
+
+	const std::vector<std::uint8_t> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	std::size_t offset = sizeof(replay_magic);
+
+	if (buffer.size() < offset + 1 || !std::equal(std::begin(replay_magic), std::end(replay_magic), buffer.begin()) || buffer[offset++] != replay_version)
+	{
+		printf("'%s' is not a supported replay file!\n", path.c_str());
+		return false;
+	}
+
+	std::uint64_t width = 0;
+	std::uint64_t height = 0;
+	std::uint64_t seed = 0;
+	std::uint64_t piece_source_mode = 0;
+	std::uint64_t tick_rate = 0;
+	std::uint64_t das_ms = 0;
+	std::uint64_t arr_ms = 0;
+	std::uint64_t soft_drop_factor = 0;
+	std::uint64_t event_count = 0;
+
+	bool valid = ReadVarint(buffer, &offset, &width) 
+		&& ReadVarint(buffer, &offset, &height) 
+		&& ReadFixed(buffer, &offset, &seed, 4) 
+		&& ReadFixed(buffer, &offset, &piece_source_mode, 1) 
+		&& piece_source_mode < static_cast<std::uint64_t>(PieceSourceMode::COUNT) 
+		&& ReadVarint(buffer, &offset, &tick_rate) 
+		&& ReadVarint(buffer, &offset, &das_ms) 
+		&& ReadVarint(buffer, &offset, &arr_ms) 
+		&& ReadVarint(buffer, &offset, &soft_drop_factor) 
+		&& tick_rate > 0 && tick_rate <= 0xffff && das_ms <= 0xffff && arr_ms <= 0xffff && soft_drop_factor <= 0xffff 
+		&& ReadVarint(buffer, &offset, &event_count) 
+		&& event_count <= buffer.size();
+
+	std::vector<ReplayEvent> events;
+	std::uint64_t tick = 0;
+
+	for (std::uint64_t i = 0; valid && i < event_count; ++i)
+	{
+		std::uint64_t delta = 0;
+		valid = ReadVarint(buffer, &offset, &delta) && offset < buffer.size() && buffer[offset] < static_cast<std::uint8_t>(Input::COUNT);
+
+		if (valid)
+		{
+			tick += delta;
+			events.push_back({ tick, static_cast<Input>(buffer[offset++]) });
+		}
+	}
+
+	std::uint64_t final_ticks = 0;
+	std::uint64_t final_score = 0;
+	std::uint64_t final_lines = 0;
+	std::uint64_t final_board_hash = 0;
+
+	valid = valid 
+		&& ReadVarint(buffer, &offset, &final_ticks) 
+		&& ReadVarint(buffer, &offset, &final_score) 
+		&& ReadVarint(buffer, &offset, &final_lines) 
+		&& ReadFixed(buffer, &offset, &final_board_hash, 8) 
+		&& width > 0 && width <= Bitboard::max_width && height > 0;
+
+	if (!valid)
+	{
+		printf("Replay file '%s' is truncated or corrupt!\n", path.c_str());
+		return false;
+	}
+
+	if (width < Engine::min_cells_width || height < Engine::min_cells_height || height > Bitboard::max_height)
+	{
+		printf("Replay file '%s' has an unsupported %llux%llu board!\n", path.c_str(), static_cast<unsigned long long>(width), static_cast<unsigned long long>(height));
+		return false;
+	}
+
+	cells_width_ = static_cast<int>(width);
+	cells_height_ = static_cast<int>(height);
+	seed_ = static_cast<std::uint32_t>(seed);
+	piece_source_mode_ = static_cast<PieceSourceMode>(piece_source_mode);
+	handling_ = { static_cast<int>(das_ms), static_cast<int>(arr_ms), static_cast<int>(soft_drop_factor) };
+	tick_rate_ = static_cast<int>(tick_rate);
+	events_ = std::move(events);
+	final_ticks_ = final_ticks;
+	final_score_ = static_cast<int>(final_score);
+	final_lines_ = static_cast<int>(final_lines);
+	final_board_hash_ = final_board_hash;
+	next_event_ = 0;
+	return true;
+}
+
+std::unique_ptr<Engine> Replay::CreateEngine() const
+{
+	std::unique_ptr<Engine> engine = std::make_unique<Engine>(cells_width_, cells_height_, seed_, piece_source_mode_);
+	engine->SetHandling(handling_);
+	engine->SetTickRate(tick_rate_);
+	return engine;
+}
+
+void Replay::ApplyEvents(Engine* engine, std::uint64_t tick)
+{
+	assert(engine != nullptr);
+
+	while (next_event_ < events_.size() && events_[next_event_].tick_ <= tick)
+	{
+		engine->ApplyInput(events_[next_event_].input_);
+		++next_event_;
+	}
+}
+
+bool Replay::IsFinished(std::uint64_t tick) const
+{
+	return tick >= final_ticks_ && next_event_ >= events_.size();
+}
+
+bool Replay::Verify(const Engine& engine, std::uint64_t ticks) const
+{
+	const bool matches = ticks == final_ticks_ 
+		&& engine.GetScore() == final_score_ 
+		&& engine.GetLines() == final_lines_ 
+		&& engine.GetBoardHash() == final_board_hash_;
+
+	printf("Replay %s: ticks %llu/%llu, score %d/%d, lines %d/%d, board hash %016llx/%016llx\n", 
+		matches ? "verified" : "MISMATCH", 
+		static_cast<unsigned long long>(ticks), static_cast<unsigned long long>(final_ticks_), 
+		engine.GetScore(), final_score_, 
+		engine.GetLines(), final_lines_, 
+		static_cast<unsigned long long>(engine.GetBoardHash()), static_cast<unsigned long long>(final_board_hash_));
+
+	return matches;
+}
+
+std::uint64_t Replay::GetFinalTicks() const
+{
+	return final_ticks_;
+}
@@ -0,0 +1,77 @@
+#include "TetrisEnvironment.h"
+#include "VectorEnvironment.hpp"
+
+struct TetrisEnvironment
+{
+	VectorEnvironment environment_;
+};
+
+TetrisEnvironment* tetris_environment_create(size_t environments, uint32_t seed, size_t threads, int ticks_per_step)
+{
+	const VectorEnvironmentOptions options = { environments, seed, threads, ticks_per_step, PieceSourceMode::SEVEN_BAG };
+
+	try
+	{
+		return new TetrisEnvironment{ VectorEnvironment(options) };
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+void tetris_environment_destroy(TetrisEnvironment* environment)
+{
+	delete environment;
+}
+
+size_t tetris_environment_size(const TetrisEnvironment* environment)
+{
+	return environment->environment_.GetSize();
+}
+
+size_t tetris_environment_observation_size(const TetrisEnvironment* environment)
+{
+	return environment->environment_.GetObservationSize();
+}
+
+size_t tetris_environment_action_count(void)
+{
+	return VectorEnvironment::action_count;
+}
+
+int tetris_environment_reset(TetrisEnvironment* environment, uint8_t* observations)
+{
+	if (environment == nullptr || observations == nullptr)
+	{
+		return -1;
+	}
+
+	try
+	{
+		environment->environment_.Reset(observations);
+		return 0;
+	}
+	catch (...)
+	{
+		return -1;
+	}
+}
+
+int tetris_environment_step(TetrisEnvironment* environment, const uint8_t* actions, uint8_t* observations, float* rewards, uint8_t* dones)
+{
+	if (environment == nullptr || actions == nullptr || observations == nullptr || rewards == nullptr || dones == nullptr)
+	{
+		return -1;
+	}
+
+	try
+	{
+		environment->environment_.Step(actions, observations, rewards, dones);
+		return 0;
+	}
+	catch (...)
+	{
+		return -1;
+	}
+}
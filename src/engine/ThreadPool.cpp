@@ -0,0 +1,166 @@
+#include "ThreadPool.hpp"
+
+#include <utility>
+
+namespace
+{
+	thread_local const ThreadPool* current_pool = nullptr;
+	thread_local std::size_t current_worker = 0;
+}
+
+ThreadPool::ThreadPool(std::size_t threads) : 
+	workers_(), 
+	threads_(), 
+	queued_(0), 
+	pending_(0), 
+	stopping_(false), 
+	next_worker_(0), 
+	steals_(0)
+{
+	if (threads == 0)
+	{
+		threads = std::thread::hardware_concurrency();
+	}
+
+	if (threads == 0)
+	{
+		threads = 1;
+	}
+
+	for (std::size_t i = 0; i < threads; ++i)
+	{
+		workers_.push_back(std::make_unique<Worker>());
+	}
+
+	for (std::size_t i = 0; i < threads; ++i)
+	{
+		threads_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	Wait();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+
+	work_available_.notify_all();
+
+	for (std::thread& thread : threads_)
+	{
+		thread.join();
+	}
+}
+
+std::size_t ThreadPool::GetThreadCount() const
+{
+	return threads_.size();
+}
+
+std::uint64_t ThreadPool::GetSteals() const
+{
+	return steals_.load(std::memory_order_relaxed);
+}
+
+void ThreadPool::Submit(Task task)
+{
+	const std::size_t index = current_pool == this
+		? current_worker
+		: next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+
+	// Count the task before it becomes stealable, or a thief could finish it first and let Wait return
+	// while the submitting task is still running.
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		++queued_;
+		++pending_;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(workers_[index]->mutex_);
+		workers_[index]->tasks_.push_back(std::move(task));
+	}
+
+	work_available_.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	work_done_.wait(lock, [this]() { return pending_ == 0; });
+}
+
+void ThreadPool::WorkerLoop(std::size_t index)
+{
+	current_pool = this;
+	current_worker = index;
+
+	while (true)
+	{
+		Task task;
+
+		if (TryPop(index, &task) || TrySteal(index, &task))
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				--queued_;
+			}
+
+			task();
+
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			if (--pending_ == 0)
+			{
+				work_done_.notify_all();
+			}
+
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		work_available_.wait(lock, [this]() { return stopping_ || queued_ > 0; });
+
+		if (stopping_ && queued_ == 0)
+		{
+			return;
+		}
+	}
+}
+
+bool ThreadPool::TryPop(std::size_t index, Task* task)
+{
+	Worker& worker = *workers_[index];
+	std::lock_guard<std::mutex> lock(worker.mutex_);
+
+	if (worker.tasks_.empty())
+	{
+		return false;
+	}
+
+	*task = std::move(worker.tasks_.back());
+	worker.tasks_.pop_back();
+	return true;
+}
+
+bool ThreadPool::TrySteal(std::size_t index, Task* task)
+{
+	for (std::size_t i = 1; i < workers_.size(); ++i)
+	{
+		Worker& victim = *workers_[(index + i) % workers_.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex_);
+
+		if (!victim.tasks_.empty())
+		{
+			*task = std::move(victim.tasks_.front());
+			victim.tasks_.pop_front();
+			steals_.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	return false;
+}
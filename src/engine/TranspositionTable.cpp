@@ -0,0 +1,53 @@
+#include "TranspositionTable.hpp"
+
+#include <cassert>
+#include <cstring>
+
+TranspositionTable::TranspositionTable(int bits) : 
+	entries_(std::make_unique<Entry[]>(std::size_t(1) << bits)), 
+	mask_((std::size_t(1) << bits) - 1)
+{
+	assert(bits > 0 && bits < 32);
+
+	Clear();
+}
+
+void TranspositionTable::Clear()
+{
+	for (std::size_t i = 0; i <= mask_; ++i)
+	{
+		entries_[i].check_.store(0, std::memory_order_relaxed);
+		entries_[i].data_.store(0, std::memory_order_relaxed);
+	}
+}
+
+bool TranspositionTable::Probe(std::uint64_t key, double* value) const
+{
+	const Entry& entry = entries_[key & mask_];
+	const std::uint64_t data = entry.data_.load(std::memory_order_relaxed);
+	const std::uint64_t check = entry.check_.load(std::memory_order_relaxed);
+
+	if ((check ^ data) != key || check == 0)
+	{
+		return false;
+	}
+
+	std::memcpy(value, &data, sizeof(data));
+	return true;
+}
+
+void TranspositionTable::Store(std::uint64_t key, double value)
+{
+	Entry& entry = entries_[key & mask_];
+	std::uint64_t data = 0;
+
+	std::memcpy(&data, &value, sizeof(data));
+
+	entry.data_.store(data, std::memory_order_relaxed);
+	entry.check_.store(key ^ data, std::memory_order_relaxed);
+}
+
+std::size_t TranspositionTable::GetSize() const
+{
+	return mask_ + 1;
+}
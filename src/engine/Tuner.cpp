@@ -0,0 +1,308 @@
+#include "Tuner.hpp"
+#include "Constants.hpp"
+#include "Engine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
+namespace
+{
+	Tuner::Vector ToVector(const BotWeights& weights)
+	{
+		return { weights.aggregate_height_, weights.holes_, weights.bumpiness_, weights.lines_cleared_, weights.row_transitions_, weights.wells_ };
+	}
+
+	BotWeights ToWeights(const Tuner::Vector& vector)
+	{
+		return { vector[0], vector[1], vector[2], vector[3], vector[4], vector[5] };
+	}
+
+	void Normalize(Tuner::Vector* vector)
+	{
+		double length = 0.0;
+
+		for (double value : *vector)
+		{
+			length += value * value;
+		}
+
+		length = std::sqrt(length);
+
+		if (length > 0.0)
+		{
+			for (double& value : *vector)
+			{
+				value /= length;
+			}
+		}
+	}
+
+	void WriteWeights(std::ofstream& file, const BotWeights& weights)
+	{
+		file << '[' << weights.aggregate_height_ << ", " << weights.holes_ << ", " << weights.bumpiness_ << ", " << weights.lines_cleared_ << ", " << weights.row_transitions_ << ", " << weights.wells_ << ']';
+	}
+}
+
+Tuner::Tuner(const TunerOptions& options) : 
+	options_(options), 
+	thread_pool_(std::make_unique<ThreadPool>(options.threads_)), 
+	generator_(options.seed_), 
+	mean_(ToVector(options.bot_options_.weights_)), 
+	deviations_(), 
+	candidates_(), 
+	lines_(), 
+	placements_(), 
+	generations_(), 
+	best_weights_(options.bot_options_.weights_), 
+	best_fitness_(-1.0), 
+	total_placements_(0)
+{
+	options_.population_ = std::max<std::size_t>(options_.population_, 2);
+	options_.games_ = std::max<std::size_t>(options_.games_, 1);
+
+	Normalize(&mean_);
+	deviations_.fill(options_.initial_deviation_);
+}
+
+std::uint64_t Tuner::PlayGame(const Vector& weights, std::uint32_t seed, std::uint64_t* placements) const
+{
+	Engine engine(constants::board_cells_width, constants::board_cells_height, seed, options_.piece_source_mode_);
+
+	BotOptions bot_options = options_.bot_options_;
+	bot_options.weights_ = ToWeights(weights);
+
+	Bot bot(bot_options);
+	BotPlan plan;
+
+	for (std::uint64_t pieces = 0; pieces < options_.max_pieces_ && !engine.IsGameOver(); ++pieces)
+	{
+		if (!bot.Think(engine, &plan))
+		{
+			break;
+		}
+
+		if (plan.stash_)
+		{
+			engine.TriggerStashTetromino();
+		}
+
+		if (!engine.PlacePiece(plan.target_))
+		{
+			break;
+		}
+	}
+
+	*placements = bot.GetEvaluatedPlacements();
+
+	return static_cast<std::uint64_t>(engine.GetLines());
+}
+
+void Tuner::RunGeneration()
+{
+	const auto start = std::chrono::steady_clock::now();
+	const std::size_t population = options_.population_;
+	const std::size_t games = options_.games_;
+	const std::uint32_t games_seed = generator_();
+
+	std::normal_distribution<double> distribution(0.0, 1.0);
+
+	candidates_.resize(population);
+
+	for (Vector& candidate : candidates_)
+	{
+		for (std::size_t i = 0; i < parameters; ++i)
+		{
+			candidate[i] = mean_[i] + deviations_[i] * distribution(generator_);
+		}
+
+		Normalize(&candidate);
+	}
+
+	lines_.assign(population * games, 0);
+	placements_.assign(population * games, 0);
+
+	for (std::size_t i = 0; i < population * games; ++i)
+	{
+		const std::uint32_t seed = games_seed + static_cast<std::uint32_t>(i % games);
+
+		thread_pool_->Submit([this, i, seed]()
+		{
+			lines_[i] = PlayGame(candidates_[i / options_.games_], seed, &placements_[i]);
+		});
+	}
+
+	thread_pool_->Wait();
+
+	total_placements_ = std::accumulate(placements_.begin(), placements_.end(), total_placements_);
+
+	std::vector<double> fitness(population, 0.0);
+
+	for (std::size_t i = 0; i < population * games; ++i)
+	{
+		fitness[i / games] += static_cast<double>(lines_[i]) / games;
+	}
+
+	std::vector<std::size_t> order(population);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&fitness](std::size_t lhs, std::size_t rhs)
+	{
+		return fitness[lhs] > fitness[rhs];
+	});
+
+	const std::size_t elites = std::clamp<std::size_t>(static_cast<std::size_t>(std::ceil(population * options_.elite_fraction_)), 1, population);
+	const double noise = options_.noise_ * std::max(0.0, 1.0 - static_cast<double>(generations_.size()) / std::max<std::size_t>(options_.generations_, 1));
+
+	Vector mean = {};
+	Vector variance = {};
+	double elite_fitness = 0.0;
+
+	for (std::size_t i = 0; i < elites; ++i)
+	{
+		elite_fitness += fitness[order[i]] / elites;
+
+		for (std::size_t j = 0; j < parameters; ++j)
+		{
+			mean[j] += candidates_[order[i]][j] / elites;
+		}
+	}
+
+	for (std::size_t i = 0; i < elites; ++i)
+	{
+		for (std::size_t j = 0; j < parameters; ++j)
+		{
+			const double delta = candidates_[order[i]][j] - mean[j];
+			variance[j] += delta * delta / elites;
+		}
+	}
+
+	for (std::size_t j = 0; j < parameters; ++j)
+	{
+		mean_[j] = mean[j];
+		deviations_[j] = std::sqrt(variance[j] + noise);
+	}
+
+	const BotWeights generation_best = ToWeights(candidates_[order[0]]);
+
+	if (fitness[order[0]] > best_fitness_)
+	{
+		best_fitness_ = fitness[order[0]];
+		best_weights_ = generation_best;
+	}
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	generations_.push_back(
+	{
+		population * games, 
+		fitness[order[0]], 
+		std::accumulate(fitness.begin(), fitness.end(), 0.0) / population, 
+		elite_fitness, 
+		generation_best, 
+		ToWeights(mean_), 
+		ToWeights(deviations_), 
+		elapsed.count()
+	});
+}
+
+void Tuner::Run()
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	printf("Tuning: %llu generations, %llu candidates, %llu games each, %llu threads\n", 
+		static_cast<unsigned long long>(options_.generations_), 
+		static_cast<unsigned long long>(options_.population_), 
+		static_cast<unsigned long long>(options_.games_), 
+		static_cast<unsigned long long>(thread_pool_->GetThreadCount()));
+
+	for (std::size_t i = 0; i < options_.generations_; ++i)
+	{
+		RunGeneration();
+
+		const TunerGeneration& generation = generations_.back();
+
+		printf("Generation %llu: best %.1f, mean %.1f, elite %.1f lines, %.3f s\n", 
+			static_cast<unsigned long long>(i + 1), 
+			generation.best_fitness_, 
+			generation.mean_fitness_, 
+			generation.elite_fitness_, 
+			generation.seconds_);
+
+		if (!options_.output_path_.empty())
+		{
+			Dump(options_.output_path_);
+		}
+	}
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	printf("Best weights: %.6f,%.6f,%.6f,%.6f,%.6f,%.6f (%.1f lines)\n", 
+		best_weights_.aggregate_height_, 
+		best_weights_.holes_, 
+		best_weights_.bumpiness_, 
+		best_weights_.lines_cleared_, 
+		best_weights_.row_transitions_, 
+		best_weights_.wells_, 
+		best_fitness_);
+	printf("Elapsed: %.3f s, Placements per second: %.0f, Steals: %llu\n", 
+		elapsed.count(), 
+		elapsed.count() > 0.0 ? total_placements_ / elapsed.count() : 0.0, 
+		static_cast<unsigned long long>(thread_pool_->GetSteals()));
+}
+
+bool Tuner::Dump(const std::string& path) const
+{
+	std::ofstream file(path, std::ios::trunc);
+
+	if (!file)
+	{
+		printf("Unable to open tuner output '%s' for writing!\n", path.c_str());
+		return false;
+	}
+
+	file.precision(9);
+
+	file << "{\n  \"best_fitness\": " << best_fitness_ << ",\n  \"best_weights\": ";
+	WriteWeights(file, best_weights_);
+	file << ",\n  \"generations\": [\n";
+
+	for (std::size_t i = 0; i < generations_.size(); ++i)
+	{
+		const TunerGeneration& generation = generations_[i];
+
+		file << "    { \"games\": " << generation.games_
+			<< ", \"best_fitness\": " << generation.best_fitness_
+			<< ", \"mean_fitness\": " << generation.mean_fitness_
+			<< ", \"elite_fitness\": " << generation.elite_fitness_
+			<< ", \"best_weights\": ";
+		WriteWeights(file, generation.best_weights_);
+		file << ", \"mean_weights\": ";
+		WriteWeights(file, generation.mean_weights_);
+		file << ", \"deviations\": ";
+		WriteWeights(file, generation.deviations_);
+		file << ", \"seconds\": " << generation.seconds_ << " }"
+			<< (i + 1 < generations_.size() ? ",\n" : "\n");
+	}
+
+	file << "  ]\n}\n";
+
+	return static_cast<bool>(file);
+}
+
+const std::vector<TunerGeneration>& Tuner::GetGenerations() const
+{
+	return generations_;
+}
+
+const BotWeights& Tuner::GetBestWeights() const
+{
+	return best_weights_;
+}
+
+double Tuner::GetBestFitness() const
+{
+	return best_fitness_;
+}
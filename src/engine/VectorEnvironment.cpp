@@ -0,0 +1,189 @@
+#include "VectorEnvironment.hpp"
+#include "Constants.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace
+{
+	using ExpandedByte = std::array<std::uint8_t, 8>;
+
+	constexpr std::array<ExpandedByte, 256> MakeExpandedBytes()
+	{
+		std::array<ExpandedByte, 256> bytes = {};
+
+		for (std::size_t value = 0; value < bytes.size(); ++value)
+		{
+			for (std::size_t bit = 0; bit < 8; ++bit)
+			{
+				bytes[value][bit] = static_cast<std::uint8_t>((value >> bit) & 1u);
+			}
+		}
+
+		return bytes;
+	}
+
+	// Row masks are written eight cells at a time from this table instead of bit by bit.
+	constexpr std::array<ExpandedByte, 256> expanded_bytes = MakeExpandedBytes();
+
+	constexpr std::size_t tasks_per_thread = 4;
+
+	void WriteRow(Bitboard::Row row, int width, std::uint8_t* cells)
+	{
+		for (int x = 0; x < width; x += 8)
+		{
+			std::memcpy(cells + x, expanded_bytes[(row >> x) & 0xffu].data(), std::min(width - x, 8));
+		}
+	}
+
+	std::uint8_t EncodeType(TetrominoType type)
+	{
+		return static_cast<std::uint8_t>(static_cast<std::size_t>(type) + 1);
+	}
+}
+
+VectorEnvironment::VectorEnvironment(const VectorEnvironmentOptions& options) : 
+	options_(options), 
+	engines_(), 
+	thread_pool_(options.threads_ != 1 ? std::make_unique<ThreadPool>(options.threads_) : nullptr), 
+	plane_size_(static_cast<std::size_t>(constants::board_cells_width * constants::board_cells_height)), 
+	observation_size_(2 * plane_size_ + 2 + preview + 2)
+{
+	options_.ticks_per_step_ = std::max(options_.ticks_per_step_, 1);
+	engines_.reserve(options_.environments_);
+
+	for (std::size_t i = 0; i < options_.environments_; ++i)
+	{
+		engines_.emplace_back(constants::board_cells_width, constants::board_cells_height, options_.seed_ + static_cast<std::uint32_t>(i), options_.piece_source_mode_);
+	}
+}
+
+std::size_t VectorEnvironment::GetSize() const
+{
+	return engines_.size();
+}
+
+std::size_t VectorEnvironment::GetObservationSize() const
+{
+	return observation_size_;
+}
+
+const Engine& VectorEnvironment::GetEngine(std::size_t index) const
+{
+	return engines_[index];
+}
+
+void VectorEnvironment::Reset(std::uint8_t* observations)
+{
+	ForEachRange([this, observations](std::size_t first, std::size_t last)
+	{
+		for (std::size_t i = first; i < last; ++i)
+		{
+			engines_[i].Reset();
+			WriteObservation(i, observations + i * observation_size_);
+		}
+	});
+}
+
+void VectorEnvironment::Step(const std::uint8_t* actions, std::uint8_t* observations, float* rewards, std::uint8_t* dones)
+{
+	ForEachRange([this, actions, observations, rewards, dones](std::size_t first, std::size_t last)
+	{
+		StepRange(first, last, actions, observations, rewards, dones);
+	});
+}
+
+void VectorEnvironment::StepRange(std::size_t first, std::size_t last, const std::uint8_t* actions, std::uint8_t* observations, float* rewards, std::uint8_t* dones)
+{
+	for (std::size_t i = first; i < last; ++i)
+	{
+		Engine& engine = engines_[i];
+		const int score = engine.GetScore();
+
+		if (actions[i] < no_action)
+		{
+			engine.ApplyInput(static_cast<Input>(actions[i]));
+		}
+
+		for (int tick = 0; tick < options_.ticks_per_step_; ++tick)
+		{
+			engine.Tick();
+		}
+
+		rewards[i] = static_cast<float>(engine.GetScore() - score);
+		dones[i] = engine.IsGameOver() ? 1 : 0;
+
+		if (dones[i] != 0)
+		{
+			engine.Reset();
+		}
+
+		WriteObservation(i, observations + i * observation_size_);
+	}
+}
+
+void VectorEnvironment::WriteObservation(std::size_t index, std::uint8_t* observation) const
+{
+	const Engine& engine = engines_[index];
+	const int width = engine.cells_width_;
+	const int height = engine.cells_height_;
+
+	for (int y = 0; y < height; ++y)
+	{
+		WriteRow(engine.bitboard_.GetRow(y), width, observation + y * width);
+	}
+
+	std::uint8_t* falling = observation + plane_size_;
+	std::fill(falling, falling + plane_size_, 0);
+
+	const PieceState& piece = engine.GetFallingPiece();
+
+	for (const rotation_tables::Offset& offset : piece.GetShape())
+	{
+		const int x = piece.x_ + offset.x;
+		const int y = piece.y_ + offset.y;
+
+		if (x >= 0 && x < width && y >= 0 && y < height)
+		{
+			falling[y * width + x] = 1;
+		}
+	}
+
+	std::uint8_t* info = observation + 2 * plane_size_;
+
+	*info++ = EncodeType(piece.type_);
+	*info++ = piece.rotation_;
+
+	for (std::size_t i = 0; i < preview; ++i)
+	{
+		*info++ = EncodeType(engine.GetQueuedType(i));
+	}
+
+	const std::optional<TetrominoType>& stashed_type = engine.GetStashedType();
+
+	*info++ = stashed_type.has_value() ? EncodeType(*stashed_type) : 0;
+	*info++ = engine.CanStash() ? 1 : 0;
+}
+
+void VectorEnvironment::ForEachRange(const std::function<void(std::size_t, std::size_t)>& function)
+{
+	const std::size_t size = engines_.size();
+
+	if (thread_pool_ == nullptr)
+	{
+		function(0, size);
+		return;
+	}
+
+	const std::size_t tasks = thread_pool_->GetThreadCount() * tasks_per_thread;
+	const std::size_t chunk = std::max<std::size_t>((size + tasks - 1) / tasks, 1);
+
+	for (std::size_t first = 0; first < size; first += chunk)
+	{
+		const std::size_t last = std::min(first + chunk, size);
+		thread_pool_->Submit([&function, first, last]() { function(first, last); });
+	}
+
+	thread_pool_->Wait();
+}
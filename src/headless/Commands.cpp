@@ -0,0 +1,174 @@
+#include "Headless.hpp"
+#include "GameServer.hpp"
+#include "Tuner.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+
+bool ParseBotOption(int argc, char* argv[], int* index, bool* enabled, BotOptions* options)
+{
+	const char* argument = argv[*index];
+
+	if (std::strcmp(argument, "--bot") == 0)
+	{
+		*enabled = true;
+		return true;
+	}
+
+	if (std::strcmp(argument, "--bot-stash") == 0)
+	{
+		*enabled = true;
+		options->use_stash_ = true;
+		return true;
+	}
+
+	if (std::strcmp(argument, "--bot-lookahead") == 0 && *index + 1 < argc)
+	{
+		*enabled = true;
+		options->lookahead_ = std::atoi(argv[++(*index)]);
+		return true;
+	}
+
+	if (std::strcmp(argument, "--bot-cache-bits") == 0 && *index + 1 < argc)
+	{
+		*enabled = true;
+		options->transposition_bits_ = std::clamp(std::atoi(argv[++(*index)]), 0, 28);
+		return true;
+	}
+
+	if (std::strcmp(argument, "--bot-weights") == 0 && *index + 1 < argc)
+	{
+		BotWeights& weights = options->weights_;
+		const char* value = argv[++(*index)];
+
+		const int parsed = std::sscanf(value, "%lf,%lf,%lf,%lf,%lf,%lf", &weights.aggregate_height_, &weights.holes_, &weights.bumpiness_, &weights.lines_cleared_, &weights.row_transitions_, &weights.wells_);
+
+		if (parsed != 4 && parsed != 6)
+		{
+			printf("Invalid bot weights '%s'! Expected height,holes,bumpiness,lines[,transitions,wells].\n", value);
+		}
+
+		*enabled = true;
+		return true;
+	}
+
+	return false;
+}
+
+int RunGameServer(int argc, char* argv[])
+{
+	GameServerOptions options = { 64, 100000, std::random_device()(), 0, 0, 10000, PieceSourceMode::SEVEN_BAG, false, Bot::GetDefaultOptions() };
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (ParseBotOption(argc, argv, &i, &options.bot_, &options.bot_options_))
+		{
+			continue;
+		}
+		else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc)
+		{
+			options.games_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+		{
+			options.ticks_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			options.seed_ = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--input-seed") == 0 && i + 1 < argc)
+		{
+			options.input_seed_ = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			options.threads_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--chunk-ticks") == 0 && i + 1 < argc)
+		{
+			options.chunk_ticks_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--randomizer") == 0 && i + 1 < argc)
+		{
+			if (!PieceSource::ParseMode(argv[++i], &options.piece_source_mode_))
+			{
+				printf("Unknown randomizer '%s'! Expected 7bag, 14bag or classic.\n", argv[i]);
+				return 1;
+			}
+		}
+	}
+
+	const std::unique_ptr<GameServer> server = std::make_unique<GameServer>(options);
+	server->Run();
+
+	return 0;
+}
+
+int RunTuner(int argc, char* argv[])
+{
+	TunerOptions options = { 20, 32, 8, 10000, 0.25, 0.5, 0.1, std::random_device()(), 0, PieceSourceMode::SEVEN_BAG, Bot::GetDefaultOptions(), "" };
+	bool bot = true;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (ParseBotOption(argc, argv, &i, &bot, &options.bot_options_))
+		{
+			continue;
+		}
+		else if (std::strcmp(argv[i], "--generations") == 0 && i + 1 < argc)
+		{
+			options.generations_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--population") == 0 && i + 1 < argc)
+		{
+			options.population_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc)
+		{
+			options.games_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--max-pieces") == 0 && i + 1 < argc)
+		{
+			options.max_pieces_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--elite") == 0 && i + 1 < argc)
+		{
+			options.elite_fraction_ = std::atof(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			options.seed_ = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			options.threads_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+		{
+			options.output_path_ = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--randomizer") == 0 && i + 1 < argc)
+		{
+			if (!PieceSource::ParseMode(argv[++i], &options.piece_source_mode_))
+			{
+				printf("Unknown randomizer '%s'! Expected 7bag, 14bag or classic.\n", argv[i]);
+				return 1;
+			}
+		}
+	}
+
+	const std::unique_ptr<Tuner> tuner = std::make_unique<Tuner>(options);
+	tuner->Run();
+
+	if (!options.output_path_.empty() && !tuner->Dump(options.output_path_))
+	{
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,228 @@
+#include "Headless.hpp"
+#include "Constants.hpp"
+#include "GameServer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+Headless::Headless(const HeadlessOptions& options) : 
+	options_(options), 
+	engine_(std::make_unique<Engine>(constants::board_cells_width, constants::board_cells_height, options.seed_, options.piece_source_mode_)), 
+	replay_(nullptr), 
+	bot_player_(options.bot_ ? std::make_unique<BotPlayer>(options.bot_options_) : nullptr), 
+	bot_inputs_(), 
+	input_generator_(options.input_seed_), 
+	tick_(0), 
+	games_(0)
+{
+	if (!options_.record_path_.empty())
+	{
+		replay_ = std::make_unique<Replay>();
+		replay_->Start(*engine_);
+	}
+}
+
+void Headless::Run()
+{
+	std::uint64_t lines = 0;
+	std::uint64_t score = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (; tick_ < options_.ticks_; ++tick_)
+	{
+		if (bot_player_ != nullptr)
+		{
+			ApplyBotInputs();
+		}
+		else
+		{
+			ApplyRandomInput();
+		}
+
+		if (engine_->IsGameOver())
+		{
+			lines += engine_->GetLines();
+			score += engine_->GetScore();
+			++games_;
+			ApplyInput(Input::RESET);
+		}
+
+		engine_->Tick();
+	}
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	lines += engine_->GetLines();
+	score += engine_->GetScore();
+
+	printf("Ticks: %llu, Games: %llu, Lines: %llu, Score: %llu\n", 
+		static_cast<unsigned long long>(options_.ticks_), 
+		static_cast<unsigned long long>(games_), 
+		static_cast<unsigned long long>(lines), 
+		static_cast<unsigned long long>(score));
+	printf("Elapsed: %.3f s, Ticks per second: %.0f\n", elapsed.count(), elapsed.count() > 0.0 ? options_.ticks_ / elapsed.count() : 0.0);
+
+	if (bot_player_ != nullptr)
+	{
+		const Bot& bot = bot_player_->GetBot();
+
+		printf("Placements evaluated: %llu, Thinking: %.3f s, Placements per second: %.0f\n", 
+			static_cast<unsigned long long>(bot.GetEvaluatedPlacements()), 
+			bot.GetThinkSeconds(), 
+			bot.GetThinkSeconds() > 0.0 ? bot.GetEvaluatedPlacements() / bot.GetThinkSeconds() : 0.0);
+		printf("Cache probes: %llu, Cache hits: %.1f%%\n", 
+			static_cast<unsigned long long>(bot.GetCacheProbes()), 
+			bot.GetCacheProbes() > 0 ? 100.0 * bot.GetCacheHits() / bot.GetCacheProbes() : 0.0);
+	}
+
+	if (replay_ != nullptr)
+	{
+		replay_->Finish(*engine_, tick_);
+		replay_->Save(options_.record_path_);
+	}
+}
+
+bool Headless::VerifyReplay()
+{
+	Replay replay;
+
+	if (!replay.Load(options_.verify_path_))
+	{
+		return false;
+	}
+
+	engine_ = replay.CreateEngine();
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (tick_ = 0; tick_ < replay.GetFinalTicks(); ++tick_)
+	{
+		replay.ApplyEvents(engine_.get(), tick_);
+		engine_->Tick();
+	}
+
+	replay.ApplyEvents(engine_.get(), tick_);
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	printf("Elapsed: %.3f s\n", elapsed.count());
+
+	return replay.Verify(*engine_, tick_);
+}
+
+void Headless::ApplyInput(Input input)
+{
+	if (replay_ != nullptr)
+	{
+		replay_->Record(tick_, input);
+	}
+
+	engine_->ApplyInput(input);
+}
+
+void Headless::ApplyRandomInput()
+{
+	Input input = Input::COUNT;
+
+	if (ChooseRandomInput(input_generator_, &input))
+	{
+		ApplyInput(input);
+	}
+}
+
+void Headless::ApplyBotInputs()
+{
+	bot_player_->Update(*engine_, &bot_inputs_);
+
+	for (Input input : bot_inputs_)
+	{
+		ApplyInput(input);
+	}
+
+	bot_inputs_.clear();
+}
+
+namespace
+{
+	void PrintUsage()
+	{
+		printf("Usage: headless [--ticks N] [--seed N] [--input-seed N] [--randomizer 7bag|14bag|classic] [--record FILE] [--verify FILE]\n"
+			"                [--bot] [--bot-lookahead N] [--bot-stash] [--bot-cache-bits N] [--bot-weights a,b,c,d[,e,f]]\n"
+			"       headless --server [options]\n"
+			"       headless --tune [options]\n");
+	}
+}
+
+int RunHeadless(int argc, char* argv[])
+{
+	HeadlessOptions options = { 1000000, std::random_device()(), 0, PieceSourceMode::SEVEN_BAG, false, Bot::GetDefaultOptions(), "", "" };
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--server") == 0)
+		{
+			return RunGameServer(argc, argv);
+		}
+
+		if (std::strcmp(argv[i], "--tune") == 0)
+		{
+			return RunTuner(argc, argv);
+		}
+	}
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (ParseBotOption(argc, argv, &i, &options.bot_, &options.bot_options_))
+		{
+			continue;
+		}
+		else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+		{
+			options.ticks_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			options.seed_ = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--input-seed") == 0 && i + 1 < argc)
+		{
+			options.input_seed_ = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--randomizer") == 0 && i + 1 < argc)
+		{
+			if (!PieceSource::ParseMode(argv[++i], &options.piece_source_mode_))
+			{
+				printf("Unknown randomizer '%s'! Expected 7bag, 14bag or classic.\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+		{
+			options.record_path_ = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--verify") == 0 && i + 1 < argc)
+		{
+			options.verify_path_ = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--headless") != 0)
+		{
+			printf("Unknown argument '%s'!\n", argv[i]);
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	const std::unique_ptr<Headless> headless = std::make_unique<Headless>(options);
+
+	if (!options.verify_path_.empty())
+	{
+		return headless->VerifyReplay() ? 0 : 1;
+	}
+
+	headless->Run();
+
+	return 0;
+}
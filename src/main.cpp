@@ -1,13 +1,122 @@
 #include "Game.hpp"
+#include "Headless.hpp"
 
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <random>
+
+namespace
+{
+	void PrintUsage()
+	{
+		printf("Usage: output [--seed N] [--randomizer 7bag|14bag|classic] [--das MS] [--arr MS] [--sdf N]\n"
+			"              [--tick-rate HZ] [--time-scale X|unlimited] [--max-catch-up N] [--record FILE] [--replay FILE]\n"
+			"              [--no-vsync] [--fps-cap N] [--render-on-change] [--perf-overlay] [--perf-dump PATH]\n"
+			"       output --headless [options]\n");
+	}
+}
 
 int main(int argc, char* argv[])
 {
-	(void) argc;
-	(void) argv;
+	GameOptions options = { std::random_device()(), PieceSourceMode::SEVEN_BAG, Engine::GetDefaultHandling(), Engine::default_tick_rate, 1.0, 0, "", "", true, 0, false, false, "" };
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--headless") == 0)
+		{
+			return RunHeadless(argc, argv);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			options.seed_ = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(argv[i], "--randomizer") == 0 && i + 1 < argc)
+		{
+			if (!PieceSource::ParseMode(argv[++i], &options.piece_source_mode_))
+			{
+				printf("Unknown randomizer '%s'! Expected 7bag, 14bag or classic.\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--das") == 0 && i + 1 < argc)
+		{
+			options.handling_.das_ms_ = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--arr") == 0 && i + 1 < argc)
+		{
+			options.handling_.arr_ms_ = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--sdf") == 0 && i + 1 < argc)
+		{
+			options.handling_.soft_drop_factor_ = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc)
+		{
+			options.tick_rate_ = std::atoi(argv[++i]);
+
+			if (options.tick_rate_ < 1)
+			{
+				printf("Invalid tick rate '%s'! Expected a positive number of ticks per second.\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--time-scale") == 0 && i + 1 < argc)
+		{
+			++i;
+			char* end = nullptr;
+			options.time_scale_ = std::strcmp(argv[i], "unlimited") == 0 ? 0.0 : std::strtod(argv[i], &end);
+
+			if (end != nullptr && (*end != '\0' || !std::isfinite(options.time_scale_) || options.time_scale_ <= 0.0))
+			{
+				printf("Invalid time scale '%s'! Expected a positive factor or 'unlimited'.\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--max-catch-up") == 0 && i + 1 < argc)
+		{
+			options.max_catch_up_ticks_ = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+		{
+			options.record_path_ = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+		{
+			options.replay_path_ = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--no-vsync") == 0)
+		{
+			options.vsync_ = false;
+		}
+		else if (std::strcmp(argv[i], "--fps-cap") == 0 && i + 1 < argc)
+		{
+			options.fps_cap_ = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--render-on-change") == 0)
+		{
+			options.render_on_change_ = true;
+		}
+		else if (std::strcmp(argv[i], "--perf-overlay") == 0)
+		{
+			options.perf_overlay_ = true;
+		}
+		else if (std::strcmp(argv[i], "--perf-dump") == 0 && i + 1 < argc)
+		{
+			options.perf_dump_path_ = argv[++i];
+		}
+		else
+		{
+			printf("Unknown argument '%s'!\n", argv[i]);
+			PrintUsage();
+			return 1;
+		}
+	}
 
-	const std::unique_ptr<Game> game = std::make_unique<Game>();
+	const std::unique_ptr<Game> game = std::make_unique<Game>(options);
 	game->Run();
 
 	return 0;
@@ -0,0 +1,133 @@
+#include "Bitboard.hpp"
+#include "BoardFeatures.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr std::uint32_t seed = 20;
+	constexpr int heights[] = { 4, 5, 20, 31, 32, 63, 64 };
+	constexpr std::size_t batch_sizes[] = { 1, 15, 16, 37 };
+
+	// Columns of random height with random holes under them, so boards have wells, overhangs and
+	// both empty and full rows.
+	void FillRandomBoard(std::mt19937& generator, Bitboard* bitboard)
+	{
+		const int width = bitboard->GetWidth();
+		const int height = bitboard->GetHeight();
+		const int hole_chance = static_cast<int>(generator() % 40);
+
+		bitboard->Clear();
+
+		for (int x = 0; x < width; ++x)
+		{
+			const int top = height - static_cast<int>(generator() % (height + 1));
+
+			for (int y = top; y < height; ++y)
+			{
+				bitboard->SetOccupied(x, y, static_cast<int>(generator() % 100) >= hole_chance);
+			}
+		}
+	}
+
+	bool Matches(const BoardFeatures& expected, const BoardFeatures& actual)
+	{
+		return expected.aggregate_height_ == actual.aggregate_height_ 
+			&& expected.holes_ == actual.holes_ 
+			&& expected.bumpiness_ == actual.bumpiness_ 
+			&& expected.max_height_ == actual.max_height_ 
+			&& expected.row_transitions_ == actual.row_transitions_ 
+			&& expected.wells_ == actual.wells_;
+	}
+
+	void PrintFeatures(const char* label, const BoardFeatures& features)
+	{
+		printf("  %-8s height %d, holes %d, bumpiness %d, max height %d, row transitions %d, wells %d\n", 
+			label, 
+			features.aggregate_height_, 
+			features.holes_, 
+			features.bumpiness_, 
+			features.max_height_, 
+			features.row_transitions_, 
+			features.wells_);
+	}
+}
+
+int main()
+{
+	std::mt19937 generator(seed);
+	std::vector<Bitboard> bitboards;
+	std::vector<BoardFeatures> expected;
+	std::vector<BoardFeatures> actual;
+	BoardBatch batch;
+	std::uint64_t boards = 0;
+
+	for (int width = 4; width <= Bitboard::max_width; ++width)
+	{
+		for (int height : heights)
+		{
+			for (std::size_t size : batch_sizes)
+			{
+				bitboards.assign(size, Bitboard());
+				expected.resize(size);
+				actual.resize(size);
+				batch.Reset(width, height, size);
+
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					bitboards[i].Resize(width, height);
+					FillRandomBoard(generator, &bitboards[i]);
+					expected[i] = ExtractBoardFeatures(bitboards[i]);
+					batch.Add(bitboards[i]);
+				}
+
+				for (std::size_t k = 0; k < static_cast<std::size_t>(FeatureKernel::COUNT); ++k)
+				{
+					const FeatureKernel kernel = static_cast<FeatureKernel>(k);
+
+					if (!IsFeatureKernelSupported(kernel))
+					{
+						continue;
+					}
+
+					ExtractBoardFeatures(batch, actual.data(), kernel);
+
+					for (std::size_t i = 0; i < size; ++i)
+					{
+						if (!Matches(expected[i], actual[i]))
+						{
+							printf("Feature kernels: %s disagrees with the scalar kernel on board %llu of %llu (%dx%d)!\n", 
+								GetFeatureKernelName(kernel), 
+								static_cast<unsigned long long>(i), 
+								static_cast<unsigned long long>(size), 
+								width, 
+								height);
+							PrintFeatures("scalar", expected[i]);
+							PrintFeatures(GetFeatureKernelName(kernel), actual[i]);
+							return 1;
+						}
+					}
+				}
+
+				boards += size;
+			}
+		}
+	}
+
+	printf("Feature kernels: %llu boards match the scalar kernel on", static_cast<unsigned long long>(boards));
+
+	for (std::size_t k = 0; k < static_cast<std::size_t>(FeatureKernel::COUNT); ++k)
+	{
+		if (IsFeatureKernelSupported(static_cast<FeatureKernel>(k)))
+		{
+			printf(" %s", GetFeatureKernelName(static_cast<FeatureKernel>(k)));
+		}
+	}
+
+	printf("\n");
+	return 0;
+}
@@ -0,0 +1,75 @@
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+namespace
+{
+	constexpr std::size_t threads = 4;
+	constexpr std::size_t rounds = 2000;
+	constexpr std::size_t roots = 8;
+	constexpr int depth = 4;
+
+	struct Counters
+	{
+		std::atomic<std::uint64_t> started_;
+		std::atomic<std::uint64_t> finished_;
+	};
+
+	// Each task resubmits a child from inside a worker and keeps running after it, like
+	// GameServer::StepInstance, so the child can be stolen while its parent is still live.
+	void Spawn(ThreadPool* pool, Counters* counters, int remaining)
+	{
+		counters->started_.fetch_add(1, std::memory_order_relaxed);
+
+		if (remaining > 0)
+		{
+			pool->Submit([pool, counters, remaining]() { Spawn(pool, counters, remaining - 1); });
+		}
+
+		std::this_thread::yield();
+		counters->finished_.fetch_add(1, std::memory_order_release);
+	}
+}
+
+int main()
+{
+	ThreadPool pool(threads);
+	Counters counters;
+
+	constexpr std::uint64_t expected = roots * (depth + 1);
+
+	for (std::size_t round = 0; round < rounds; ++round)
+	{
+		counters.started_ = 0;
+		counters.finished_ = 0;
+
+		for (std::size_t i = 0; i < roots; ++i)
+		{
+			pool.Submit([&pool, &counters]() { Spawn(&pool, &counters, depth); });
+		}
+
+		pool.Wait();
+
+		const std::uint64_t finished = counters.finished_.load(std::memory_order_acquire);
+
+		if (finished != expected)
+		{
+			printf("ThreadPool stress: Wait returned in round %llu with %llu of %llu tasks finished!\n", 
+				static_cast<unsigned long long>(round), 
+				static_cast<unsigned long long>(finished), 
+				static_cast<unsigned long long>(expected));
+			return 1;
+		}
+	}
+
+	printf("ThreadPool stress: %llu rounds of %llu nested tasks on %llu threads, %llu steals\n", 
+		static_cast<unsigned long long>(rounds), 
+		static_cast<unsigned long long>(expected), 
+		static_cast<unsigned long long>(pool.GetThreadCount()), 
+		static_cast<unsigned long long>(pool.GetSteals()));
+
+	return 0;
+}